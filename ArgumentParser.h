@@ -2,14 +2,19 @@
 #define AIZOPROJEKT_ARGUMENTPARSER_H
 
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 enum class Mode {
     HELP,
     FILE_TEST,
     BENCHMARK,
     DRUNK,
-    RUN_TESTS
+    RUN_TESTS,
+    MAPPED,
+    SELECT,
+    EXTERNAL
 };
 
 struct Arguments {
@@ -18,9 +23,23 @@ struct Arguments {
     int dataType = 0;
     std::string inputFile;
     std::string outputFile;
-    int size = 0;
+    size_t size = 0;
     int distribution = 0; // New field for distribution
     int drunkLevel = 0; // New field for drunk level
+    int iterations = 100; // Benchmark repetitions per test case
+    int testOption = 0; // Test suite selected in RUN_TESTS mode
+    std::string allocator = "heap"; // Memory resource for the sorted arrays (--alloc)
+    size_t threads = 0; // Threads for parallel algorithms, 0 = all hardware threads (--threads)
+    std::string gapSequence = "shell"; // Shell Sort gap sequence (--gaps)
+    int lowPivotRank = 2; // Dual-Pivot Quick Sort pivots, 1-based ranks in the five-element sample (--pivots)
+    int highPivotRank = 4;
+    size_t insertionCutoff = 27; // Dual-Pivot Quick Sort insertion sort cutoff (--cutoff)
+    std::string selection; // SELECT mode operation: nth, partial or topk
+    size_t rank = 0; // SELECT mode k
+    size_t memoryBudget = 256; // EXTERNAL mode memory budget in MiB (--memory)
+    std::string tempDirectory; // EXTERNAL mode run files, empty = system temp directory (--tmpdir)
+    int bucketAlgorithm = 7; // Sequential algorithm for the Parallel Sample Sort buckets (--bucket-sort)
+    unsigned long long sampleSeed = 42; // Parallel Sample Sort sampling seed (--seed)
 };
 
 class ArgumentParser {
@@ -28,60 +47,104 @@ public:
     static Arguments parseArguments(int argc, char* argv[]) {
         Arguments args;
 
-        if (argc < 2) {
+        // Split "--option value" pairs from the positional arguments of the mode
+        std::vector<std::string> params;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg(argv[i]);
+            if (i > 1 && arg.rfind("--", 0) == 0) {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("Missing value for option " + arg);
+                }
+                parseOption(args, arg, argv[++i]);
+            } else {
+                params.push_back(arg);
+            }
+        }
+        size_t count = params.size();
+
+        if (count < 1) {
             args.mode = Mode::HELP;
             return args;
         }
 
-        std::string modeStr(argv[1]);
+        const std::string& modeStr = params[0];
         if (modeStr == "--help") {
             args.mode = Mode::HELP;
         }
-        else if (modeStr == "--file" && argc >= 5) {
+        else if (modeStr == "--file" && count >= 4) {
             args.mode = Mode::FILE_TEST;
-            args.algorithm = std::stoi(argv[2]);
-            args.dataType = std::stoi(argv[3]);
-            args.inputFile = argv[4];
+            args.algorithm = parseAlgorithm(params[1]);
+            args.dataType = std::stoi(params[2]);
+            args.inputFile = params[3];
 
-            if (argc == 6) {
-                args.outputFile = argv[5];
+            if (count == 5) {
+                args.outputFile = params[4];
             }
         }
-        else if (modeStr == "--test" && argc >= 6) {
+        else if (modeStr == "--test" && count >= 5) {
             args.mode = Mode::BENCHMARK;
-            args.algorithm = std::stoi(argv[2]);
-            args.dataType = std::stoi(argv[3]);
-            args.size = std::stoi(argv[4]);
-            args.outputFile = argv[5];
+            args.algorithm = parseAlgorithm(params[1]);
+            args.dataType = std::stoi(params[2]);
+            args.size = std::stoull(params[3]);
+            args.outputFile = params[4];
 
-            if (argc == 7) {
-                args.distribution = std::stoi(argv[6]); // Parse distribution parameter
+            if (count == 6) {
+                args.distribution = std::stoi(params[5]); // Parse distribution parameter
             }
             else {
                 args.distribution = 0; // Default to random distribution if not provided
             }
         }
-        else if (modeStr == "--drunk" && argc >= 7) {
+        else if (modeStr == "--drunk" && count >= 6) {
             args.mode = Mode::DRUNK;
-            args.algorithm = std::stoi(argv[2]);
-            args.dataType = std::stoi(argv[3]);
-            args.size = std::stoi(argv[4]);
-            args.drunkLevel = std::stoi(argv[5]);
-            args.outputFile = argv[6];
+            args.algorithm = std::stoi(params[1]);
+            args.dataType = std::stoi(params[2]);
+            args.size = std::stoull(params[3]);
+            args.drunkLevel = std::stoi(params[4]);
+            args.outputFile = params[5];
 
             if (args.drunkLevel < 0 || args.drunkLevel > 10) {
                 args.drunkLevel = 0; // Default to sober if invalid level
             }
 
-            if (argc == 8) {
-                args.distribution = std::stoi(argv[7]); // Parse distribution parameter
+            if (count == 7) {
+                args.distribution = std::stoi(params[6]); // Parse distribution parameter
             } else {
                 args.distribution = 0; // Default to random distribution if not provided
             }
         }
-        else if (modeStr == "--run_tests") {
+        else if (modeStr == "--mmap" && count >= 4) {
+            args.mode = Mode::MAPPED;
+            args.algorithm = parseAlgorithm(params[1]);
+            args.dataType = std::stoi(params[2]);
+            args.inputFile = params[3];
+
+            if (count == 5) {
+                args.size = std::stoull(params[4]); // Regenerate the file with random data
+            }
+        }
+        else if (modeStr == "--select" && count >= 5) {
+            args.mode = Mode::SELECT;
+            args.selection = params[1];
+            args.dataType = std::stoi(params[2]);
+            args.inputFile = params[3];
+            args.rank = std::stoull(params[4]);
+
+            if (count == 6) {
+                args.outputFile = params[5];
+            }
+        }
+        else if (modeStr == "--external" && count >= 5) {
+            args.mode = Mode::EXTERNAL;
+            args.algorithm = parseAlgorithm(params[1]);
+            args.dataType = std::stoi(params[2]);
+            args.inputFile = params[3];
+            args.outputFile = params[4];
+        }
+        else if (modeStr == "--run_tests" && count >= 3) {
             args.mode = Mode::RUN_TESTS;
-            args.outputFile = argv[3];
+            args.testOption = std::stoi(params[1]);
+            args.outputFile = params[2];
         }
 
         else {
@@ -91,21 +154,71 @@ public:
         return args;
     }
 
+    // Algorithm id, or "auto" to let Auto Sort (15) choose from the data type and size
+    static int parseAlgorithm(const std::string& value) {
+        return value == "auto" ? 15 : std::stoi(value);
+    }
+
+    // Options accepted after the mode name, in any position
+    static void parseOption(Arguments& args, const std::string& name, const std::string& value) {
+        if (name == "--alloc") {
+            args.allocator = value;
+        } else if (name == "--threads") {
+            args.threads = std::stoull(value);
+        } else if (name == "--gaps") {
+            args.gapSequence = value;
+        } else if (name == "--pivots") {
+            size_t comma = value.find(',');
+            if (comma == std::string::npos) {
+                throw std::invalid_argument("--pivots expects two sample ranks, e.g. 2,4");
+            }
+            args.lowPivotRank = std::stoi(value.substr(0, comma));
+            args.highPivotRank = std::stoi(value.substr(comma + 1));
+            if (args.lowPivotRank < 1 || args.lowPivotRank >= args.highPivotRank || args.highPivotRank > 5) {
+                throw std::invalid_argument("--pivots ranks must satisfy 1 <= low < high <= 5");
+            }
+        } else if (name == "--cutoff") {
+            args.insertionCutoff = std::stoull(value);
+            if (args.insertionCutoff < 5) {
+                throw std::invalid_argument("--cutoff must be at least 5, the size of the pivot sample");
+            }
+        } else if (name == "--memory") {
+            args.memoryBudget = std::stoull(value);
+            if (args.memoryBudget < 1) {
+                throw std::invalid_argument("--memory must be at least 1 MiB");
+            }
+        } else if (name == "--tmpdir") {
+            args.tempDirectory = value;
+        } else if (name == "--bucket-sort") {
+            args.bucketAlgorithm = parseAlgorithm(value);
+        } else if (name == "--seed") {
+            args.sampleSeed = std::stoull(value);
+        } else if (name == "--iterations") {
+            args.iterations = std::stoi(value);
+            if (args.iterations < 1) {
+                throw std::invalid_argument("--iterations must be at least 1");
+            }
+        } else {
+            throw std::invalid_argument("Unknown option: " + name);
+        }
+    }
+
     static void printHelp() {
         std::cout << "Usage:\n"
                   << "FILE TEST MODE:\n"
                   << "./YourProject --file <algorithm> <type> <inputFile> [outputFile]\n"
-                  << "  <algorithm> Sorting algorithm to use (0 - Bubble, 1 - Merge, 2 - Insert, 3 - Binary Insert, 4 - Quick, 5 - Heap, 6 - Shell).\n"
+                  << "  <algorithm> Sorting algorithm to use (see ALGORITHMS below).\n"
                   << "  <type> Data type to load (e.g., 0 - int, 1 - float, 2 - char).\n"
                   << "  <inputFile> Input file containing the data to be sorted.\n"
                   << "  [outputFile] If provided, the sorted values will be saved to this file.\n\n"
                   << "BENCHMARK MODE:\n"
                   << "./YourProject --test <algorithm> <type> <size> <outputFile> [distribution]\n"
-                  << "  <algorithm> Sorting algorithm to use (0 - Bubble, 1 - Merge, 2 - Insert, 3 - Binary Insert, 4 - Quick, 5 - Heap, 6 - Shell).\n"
+                  << "  <algorithm> Sorting algorithm to use (see ALGORITHMS below).\n"
                   << "  <type> Data type to generate (e.g., 0 - int, 1 - float, 2 - char).\n"
                   << "  <size> Number of elements to generate (instance size).\n"
                   << "  <outputFile> File where the benchmark results should be saved.\n"
-                  << "  [distribution] Data distribution (0 - Random (default), 1 - Descending, 2 - Ascending, 3 - 33% sorted, 4 - 66% sorted).\n\n"
+                  << "  [distribution] Data distribution (0 - Random (default), 1 - Descending, 2 - Ascending, 3 - 33% sorted, 4 - 66% sorted,\n"
+                  << "  5 - Few unique (16 distinct keys)).\n\n"
                   << "DRUNK MODE:\n"
                   << "./YourProject --drunk <algorithm> <type> <size> <drunk level> <outputFile> [distribution] \n"
                   << "  <algorithm> Sorting algorithm to use (0 - Bubble, 1 - Quick).\n"
@@ -115,13 +228,71 @@ public:
                   << "  0 - sober (default), 1 - slightly drunk, 2 - happy, 3 - even happier, 4 - al dente, 5 - best day ever, 6 - has probably birthday.\n"
                   << "  7 - tells you how much he/she loves you, 8 - invites you to his/her weeding, 9 - wants to marry you, 10 - how is he/she still alive\n"
                   << "  <outputFile> File where the benchmark results should be saved.\n"
-                  << "  [distribution] Data distribution (0 - Random (default), 1 - Descending, 2 - Ascending, 3 - 33% sorted, 4 - 66% sorted).\n\n"
+                  << "  [distribution] Data distribution (0 - Random (default), 1 - Descending, 2 - Ascending, 3 - 33% sorted, 4 - 66% sorted,\n"
+                  << "  5 - Few unique (16 distinct keys)).\n\n"
                   << "RUN TESTS:\n"
                   << "./YourProject --run_tests <option> <outputFile>\n"
                   << "  <option> Run benchmark with given options:\n"
                   << "  0 - Every algorithm (Bubble sort, merge, insert, binary insert, heap, shell) for every data type (int, float, char)\n"
                   << "  and every size (10000, 20000, 40000, 80000, 160000) and every distribution (random, descending, ascending, 33%, 66%)\n"
+                  << "  1 - Quick sort against intro sort on the same cases (shows the sorted-input worst case)\n"
+                  << "  2 - Size sweep of quick, heap and intro sort on random ints up to 5 * 2^30 elements (64-bit indices)\n"
+                  << "  3 - Parallel quick sort against serial quick sort on 1M-16M random elements, printing the speedup\n"
+                  << "  4 - Parallel merge sort against serial merge sort on the same cases, printing the speedup\n"
+                  << "  5 - LSD radix and American flag sort against merge and heap sort on 1M-16M elements (time and scratch memory)\n"
+                  << "  6 - Block quick sort against intro sort on 1M-16M elements, printing the speedup (CSV has branch misses)\n"
+                  << "  7 - Powersort against merge sort on 1M-4M elements of every distribution, printing the speedup\n"
+                  << "  8 - 4-ary and 8-ary heap sort against binary heap sort on 64K-64M random ints, printing the speedup\n"
+                  << "  9 - Shell sort with every gap sequence on 10K-1M elements (the CSV records the sequence)\n"
+                  << "  10 - 3-way quick sort against intro sort on int and char, random and few-unique, printing the speedup\n"
+                  << "  11 - Dual-pivot quick sort against intro sort on 1M-4M elements of every type (honours --pivots and --cutoff)\n"
+                  << "  12 - Parallel sample sort against parallel quick sort on 1M-16M elements, printing the speedup\n"
                   << "  <outputFile> File where the benchmark results should be saved.\n\n"
+                  << "MAPPED FILE MODE:\n"
+                  << "./YourProject --mmap <algorithm> <type> <binaryFile> [size]\n"
+                  << "  <algorithm> Sorting algorithm to use (see ALGORITHMS below).\n"
+                  << "  <type> Element type stored in the file (0 - int, 1 - float, 2 - char).\n"
+                  << "  <binaryFile> Raw binary file of elements, sorted in place through a shared memory mapping.\n"
+                  << "  [size] If provided, the file is first overwritten with this many random elements.\n\n"
+                  << "ALGORITHMS:\n"
+                  << "  0 - Bubble, 1 - Merge, 2 - Insert, 3 - Binary Insert, 4 - Quick, 5 - Heap, 6 - Shell,\n"
+                  << "  7 - Intro (median-of-three quick sort with heap sort fallback), 8 - Parallel Quick (work-stealing, see --threads),\n"
+                  << "  9 - Parallel Merge (merge-path parallel merges, see --threads), 10 - Ping-pong Merge (single buffer, no copy-back),\n"
+                  << "  11 - Bottom-up Merge (iterative, single buffer), 12 - LSD Radix (11-bit digits),\n"
+                  << "  13 - American Flag (in-place MSD radix), 14 - Counting (char only),\n"
+                  << "  15 - Auto (counting sort for char, LSD radix for large int/float arrays, intro sort otherwise;\n"
+                  << "  also selected by passing \"auto\" as the algorithm), 16 - SIMD Merge (AVX2 sorting networks and bitonic merges),\n"
+                  << "  17 - Vector Quick (AVX2 partition, intro sort fallbacks), 18 - Block Quick (branch-free block partitioning),\n"
+                  << "  19 - Powersort (stable natural merge sort with galloping, O(n) on sorted input),\n"
+                  << "  20 - 4-ary Heap, 21 - 8-ary Heap (bottom-up sift with prefetching),\n"
+                  << "  22 - 3-Way Quick (Bentley-McIlroy, equal keys excluded from recursion),\n"
+                  << "  23 - Dual-Pivot Quick (Yaroslavskiy partitioning, see --pivots and --cutoff),\n"
+                  << "  24 - Parallel Sample (sampled splitters, buckets sorted concurrently, see --threads, --bucket-sort and --seed).\n\n"
+                  << "SELECTION MODE:\n"
+                  << "./YourProject --select <operation> <type> <inputFile> <k> [outputFile]\n"
+                  << "  <operation> nth - the element of 0-based rank k (introselect with Floyd-Rivest sampling, O(n)),\n"
+                  << "  partial - the k smallest elements in ascending order (O(n + k log k)),\n"
+                  << "  topk - the k largest elements in descending order (single pass with a k-element heap, O(n log k)).\n"
+                  << "  <type> Data type of the file (0 - int, 1 - float, 2 - char).\n"
+                  << "  <inputFile> Input file in the FILE TEST MODE format.\n"
+                  << "  [outputFile] File for the selected elements (nth writes the whole rearranged array); printed when omitted.\n\n"
+                  << "EXTERNAL SORT MODE:\n"
+                  << "./YourProject --external <algorithm> <type> <inputFile> <outputFile>\n"
+                  << "  Sorts a file larger than memory: chunks within --memory are sorted with <algorithm>, spilled to\n"
+                  << "  binary runs in --tmpdir and merged with a loser tree using double-buffered asynchronous I/O.\n"
+                  << "  <inputFile> and <outputFile> use the FILE TEST MODE format.\n\n"
+                  << "OPTIONS (accepted by every mode, after the mode name):\n"
+                  << "  --alloc <allocator> Memory for the sorted arrays: heap (default), aligned (64-byte aligned),\n"
+                  << "  thp (transparent huge pages), hugetlb (MAP_HUGETLB), arena (reused bump allocator).\n"
+                  << "  --iterations <count> Benchmark repetitions per test case (default 100).\n"
+                  << "  --threads <count> Threads used by parallel algorithms (default: all hardware threads).\n"
+                  << "  --gaps <sequence> Shell sort gaps: shell (default, n/2, n/4, ...), knuth, sedgewick, pratt, ciura, tokuda.\n"
+                  << "  --pivots <low>,<high> Dual-pivot quick sort pivots as 1-based ranks in its sorted five-element sample (default: 2,4).\n"
+                  << "  --cutoff <size> Ranges of at most this many elements are finished by insertion sort in dual-pivot quick sort (at least 5, default: 27).\n"
+                  << "  --memory <MiB> Memory budget of external sort for chunks and I/O buffers (default: 256).\n"
+                  << "  --tmpdir <directory> Directory for the temporary runs of external sort (default: system temp directory).\n"
+                  << "  --bucket-sort <algorithm> Sequential algorithm sorting the parallel sample sort buckets (default: 7 - Intro).\n"
+                  << "  --seed <number> Sampling seed of parallel sample sort; a fixed seed and thread count give identical buckets (default: 42).\n\n"
                   << "HELP MODE:\n"
                   << "./YourProject --help\n"
                   << "  Displays this help message.\n";
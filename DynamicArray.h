@@ -6,53 +6,154 @@
 #define AIZOPROJEKT_DYNAMICARRAY_H
 
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "MemoryResource.h"
+
+// Bounds checking policy for operator[] and the iterator accessors.
+// Debug builds keep the checks, release builds (NDEBUG) compile them out.
+// Define DYNAMIC_ARRAY_CHECKED to 0 or 1 to force either behaviour.
+#ifndef DYNAMIC_ARRAY_CHECKED
+#ifdef NDEBUG
+#define DYNAMIC_ARRAY_CHECKED 0
+#else
+#define DYNAMIC_ARRAY_CHECKED 1
+#endif
+#endif
 
 template <typename T>
 class DynamicArray {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // True when operator[] validates its index
+    static constexpr bool checkedAccess = DYNAMIC_ARRAY_CHECKED != 0;
+
 private:
-    T* data;            // Pointer to dynamically allocated array
+    T* items;           // Pointer to raw (uninitialized beyond size) storage
     size_t size;        // Current number of elements
     size_t capacity;    // Total capacity of the array
+    MemoryResource* resource;   // Where the storage comes from (not owned)
 
-    // Helper function to reallocate memory with new capacity
-    void resize(size_t newCapacity) {
-        T* newData = new T[newCapacity];
+    // Trivially copyable elements are relocated with resource->reallocate/memmove
+    static constexpr bool trivial = std::is_trivially_copyable_v<T>;
 
-        // Copy existing elements to new array
-        for (size_t i = 0; i < size; i++) {
-            newData[i] = data[i];
+    // Allocate raw storage for count elements without constructing them
+    T* allocate(size_t count) {
+        if (count == 0) {
+            return nullptr;
         }
+        return static_cast<T*>(resource->allocate(count * sizeof(T)));
+    }
 
-        // Delete old array
-        delete[] data;
+    // Release storage obtained from allocate
+    void release(T* memory, size_t count) {
+        if (memory != nullptr) {
+            resource->deallocate(memory, count * sizeof(T));
+        }
+    }
+
+    // Helper function to reallocate memory with new capacity
+    void reallocate(size_t newCapacity) {
+        if (newCapacity == 0) {
+            std::destroy(items, items + size);
+            release(items, capacity);
+            items = nullptr;
+            size = capacity = 0;
+            return;
+        }
 
-        // Update pointers and capacity
-        data = newData;
+        if constexpr (trivial) {
+            // The resource can grow in place or move the block without touching elements
+            items = static_cast<T*>(resource->reallocate(items, capacity * sizeof(T), newCapacity * sizeof(T)));
+        } else {
+            T* newData = allocate(newCapacity);
+            std::uninitialized_move(items, items + size, newData);
+            std::destroy(items, items + size);
+            release(items, capacity);
+            items = newData;
+        }
         capacity = newCapacity;
     }
 
+    // Capacity to grow to when the array is full
+    size_t grownCapacity() const {
+        return capacity == 0 ? 10 : capacity * 2;
+    }
+
+    // Make room for at least required elements, keeping amortized doubling
+    void ensureCapacity(size_t required) {
+        if (required > capacity) {
+            reallocate(std::max(required, grownCapacity()));
+        }
+    }
+
 public:
-    // Constructor with optional initial capacity
-    DynamicArray(size_t initialCapacity = 10) : size(0), capacity(initialCapacity) {
-        data = new T[capacity];
+    // Constructor with optional initial capacity and memory resource
+    DynamicArray(size_t initialCapacity = 10, MemoryResource* resource = MemoryResource::heap())
+            : size(0), capacity(initialCapacity), resource(resource) {
+        items = allocate(capacity);
+    }
+
+    // Copy constructor (the copy uses the same memory resource)
+    DynamicArray(const DynamicArray& other)
+            : size(other.size), capacity(other.capacity), resource(other.resource) {
+        items = allocate(capacity);
+        if constexpr (trivial) {
+            if (size > 0) {
+                std::memcpy(items, other.items, size * sizeof(T));
+            }
+        } else {
+            std::uninitialized_copy(other.items, other.items + size, items);
+        }
+    }
+
+    // Move constructor
+    DynamicArray(DynamicArray&& other) noexcept
+            : items(other.items), size(other.size), capacity(other.capacity), resource(other.resource) {
+        other.items = nullptr;
+        other.size = other.capacity = 0;
+    }
+
+    // Copy and move assignment (copy-and-swap)
+    DynamicArray& operator=(DynamicArray other) noexcept {
+        swap(other);
+        return *this;
     }
 
     // Destructor
     ~DynamicArray() {
-        delete[] data;
+        std::destroy(items, items + size);
+        release(items, capacity);
+    }
+
+    // Exchange contents with another array
+    void swap(DynamicArray& other) noexcept {
+        std::swap(items, other.items);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+        std::swap(resource, other.resource);
     }
 
     // Add element to the end of array
     void add(const T& element) {
         // Check if we need to increase capacity
         if (size == capacity) {
-            resize(capacity * 2);
+            T copy = element; // element may live inside the buffer being moved
+            reallocate(grownCapacity());
+            new (items + size) T(std::move(copy));
+        } else {
+            new (items + size) T(element);
         }
-
-        // Add element and increase size
-        data[size] = element;
         size++;
     }
 
@@ -62,19 +163,27 @@ public:
         if (index > size) {
             throw std::out_of_range("Index out of range for insertion");
         }
+        if (index == size) {
+            add(element);
+            return;
+        }
+
+        T copy = element;
 
         // Check if we need to increase capacity
         if (size == capacity) {
-            resize(capacity * 2);
+            reallocate(grownCapacity());
         }
 
         // Shift elements to make space for the new element
-        for (size_t i = size; i > index; i--) {
-            data[i] = data[i - 1];
+        if constexpr (trivial) {
+            std::memmove(items + index + 1, items + index, (size - index) * sizeof(T));
+            items[index] = copy;
+        } else {
+            new (items + size) T(std::move(items[size - 1]));
+            std::move_backward(items + index, items + size - 1, items + size);
+            items[index] = std::move(copy);
         }
-
-        // Insert element and increase size
-        data[index] = element;
         size++;
     }
 
@@ -86,8 +195,11 @@ public:
         }
 
         // Shift elements to remove the element
-        for (size_t i = index; i < size - 1; i++) {
-            data[i] = data[i + 1];
+        if constexpr (trivial) {
+            std::memmove(items + index, items + index + 1, (size - index - 1) * sizeof(T));
+        } else {
+            std::move(items + index + 1, items + size, items + index);
+            std::destroy_at(items + size - 1);
         }
 
         // Decrease size
@@ -95,7 +207,124 @@ public:
 
         // Optional: Shrink the array if it's too empty
         if (size < capacity / 4 && capacity > 10) {
-            resize(capacity / 2);
+            reallocate(capacity / 2);
+        }
+    }
+
+    // Grow capacity to at least newCapacity elements (never shrinks)
+    void reserve(size_t newCapacity) {
+        if (newCapacity > capacity) {
+            reallocate(newCapacity);
+        }
+    }
+
+    // Change the number of elements, value-initializing new ones
+    void resize(size_t newSize) {
+        if (newSize < size) {
+            std::destroy(items + newSize, items + size);
+        } else if (newSize > size) {
+            ensureCapacity(newSize);
+            std::uninitialized_value_construct(items + size, items + newSize);
+        }
+        size = newSize;
+    }
+
+    // Remove all elements, keeping the allocated capacity
+    void clear() {
+        std::destroy(items, items + size);
+        size = 0;
+    }
+
+    // Append count elements copied from source with a single capacity check
+    void appendRange(const T* source, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        ensureCapacity(size + count);
+        if constexpr (trivial) {
+            std::memcpy(items + size, source, count * sizeof(T));
+        } else {
+            std::uninitialized_copy(source, source + count, items + size);
+        }
+        size += count;
+    }
+
+    // Replace the contents with the elements of [first, last)
+    template <typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            size_t count = static_cast<size_t>(std::distance(first, last));
+            reserve(count);
+            std::uninitialized_copy(first, last, items);
+            size = count;
+        } else {
+            for (; first != last; ++first) {
+                add(*first);
+            }
+        }
+    }
+
+    // Raw storage for count elements past the end, to be filled in place and
+    // published with commit(). Elements must be constructed there (plain
+    // assignment is enough for trivially copyable types).
+    T* uninitializedTail(size_t count) {
+        ensureCapacity(size + count);
+        return items + size;
+    }
+
+    // Publish count elements written into the uninitialized tail
+    void commit(size_t count) {
+        if (size + count > capacity) {
+            throw std::out_of_range("Commit past the reserved capacity");
+        }
+        size += count;
+    }
+
+    // Move the elements of [first, last) so they start at destination. The
+    // ranges may overlap and must lie inside the array; the buffer is never
+    // reallocated; slots left behind keep their old (or moved-from) values.
+    void shiftRange(size_t first, size_t last, size_t destination) {
+        if constexpr (checkedAccess) {
+            if (first > last || last > size || destination + (last - first) > size) {
+                throw std::out_of_range("Range out of range for shift");
+            }
+        }
+        if (first == destination || first == last) {
+            return;
+        }
+        if constexpr (trivial) {
+            std::memmove(items + destination, items + first, (last - first) * sizeof(T));
+        } else if (destination < first) {
+            std::move(items + first, items + last, items + destination);
+        } else {
+            std::move_backward(items + first, items + last, items + destination + (last - first));
+        }
+    }
+
+    // Rotate [first, last) so that middle becomes the first element
+    void rotate(size_t first, size_t middle, size_t last) {
+        if constexpr (checkedAccess) {
+            if (first > middle || middle > last || last > size) {
+                throw std::out_of_range("Range out of range for rotation");
+            }
+        }
+        if (first == middle || middle == last) {
+            return;
+        }
+        if (last - middle == 1) {
+            // Single element moving to the front, as in insertion sorts
+            T moved = std::move(items[middle]);
+            shiftRange(first, middle, first + 1);
+            items[first] = std::move(moved);
+        } else if (middle - first == 1) {
+            // Single element moving to the back
+            T moved = std::move(items[first]);
+            shiftRange(middle, last, first);
+            items[last - 1] = std::move(moved);
+        } else {
+            std::rotate(items + first, items + middle, items + last);
         }
     }
 
@@ -104,7 +333,7 @@ public:
         if (index >= size) {
             throw std::out_of_range("Index out of range");
         }
-        T& value = data[index];
+        T& value = items[index];
         return value;
     }
 
@@ -113,7 +342,52 @@ public:
         if (index >= size) {
             throw std::out_of_range("Index out of range");
         }
-        data[index] = element;
+        items[index] = element;
+    }
+
+    // Element access following the checkedAccess policy
+    T& operator[](size_t index) {
+        if constexpr (checkedAccess) {
+            if (index >= size) {
+                throw std::out_of_range("Index out of range");
+            }
+        }
+        return items[index];
+    }
+
+    const T& operator[](size_t index) const {
+        if constexpr (checkedAccess) {
+            if (index >= size) {
+                throw std::out_of_range("Index out of range");
+            }
+        }
+        return items[index];
+    }
+
+    // Raw contiguous storage, valid until the next reallocation
+    T* data() {
+        return items;
+    }
+
+    const T* data() const {
+        return items;
+    }
+
+    // Iterators over the stored elements
+    iterator begin() {
+        return items;
+    }
+
+    iterator end() {
+        return items + size;
+    }
+
+    const_iterator begin() const {
+        return items;
+    }
+
+    const_iterator end() const {
+        return items + size;
     }
 
     // Get current number of elements
@@ -125,6 +399,16 @@ public:
     size_t getCapacity() const {
         return capacity;
     }
+
+    // Tell the memory resource how the elements are about to be accessed
+    void advise(AccessPattern pattern) {
+        resource->advise(items, capacity * sizeof(T), pattern);
+    }
+
+    // Get the memory resource backing this array
+    MemoryResource* getResource() const {
+        return resource;
+    }
 };
 
 
@@ -0,0 +1 @@
+#include "ExternalSorter.h"
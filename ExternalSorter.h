@@ -0,0 +1,425 @@
+#ifndef AIZOPROJEKT_EXTERNALSORTER_H
+#define AIZOPROJEKT_EXTERNALSORTER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "DynamicArray.h"
+#include "MemoryResource.h"
+
+// External merge sort for inputs larger than memory. The text input (element
+// count, then the elements, as read by FILE TEST MODE) is cut into chunks
+// that fit the memory budget; each chunk is sorted by the caller's algorithm
+// and spilled to a temporary binary run. The runs are then merged with a
+// loser tree, at most maxFanIn() at a time, into the text output. All file
+// I/O is double-buffered: the next block is read or the previous one written
+// on another thread while the current one is processed.
+template <typename T>
+class ExternalSorter {
+public:
+    using ChunkSorter = std::function<void(DynamicArray<T>*)>;
+
+    struct Statistics {
+        size_t elements = 0;
+        size_t runs = 0;        // Runs spilled to disk, 0 when the input fit in memory
+        size_t mergePasses = 0; // Passes over the data after run generation
+    };
+
+    // memoryBudget (bytes) bounds the chunk and block buffers; sorting
+    // algorithms that need O(n) scratch use it on top of their chunk
+    ExternalSorter(size_t memoryBudget, std::filesystem::path tempDirectory,
+                   MemoryResource* resource = MemoryResource::heap())
+            : memoryBudget(memoryBudget), tempDirectory(std::move(tempDirectory)), resource(resource),
+              prefix("aizo-" + std::to_string(std::random_device{}()) + "-") {
+        if (memoryBudget < 4 * sizeof(T)) {
+            throw std::invalid_argument("External sort memory budget is too small");
+        }
+        if (!std::filesystem::is_directory(this->tempDirectory)) {
+            throw std::invalid_argument("Temporary directory does not exist: " + this->tempDirectory.string());
+        }
+    }
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    // Remove any run files left behind by an exception
+    ~ExternalSorter() {
+        for (const std::filesystem::path& path : created) {
+            std::error_code ignored;
+            std::filesystem::remove(path, ignored);
+        }
+    }
+
+    // Elements sorted in memory at once; two chunks are alive while one is written
+    size_t chunkCapacity() const {
+        return std::max<size_t>(memoryBudget / (2 * sizeof(T)), 1);
+    }
+
+    // Runs merged in one pass, keeping every block at least minimumBlockBytes
+    size_t maxFanIn() const {
+        return std::max<size_t>(memoryBudget / (2 * minimumBlockBytes), 3) - 1;
+    }
+
+    // Sort the text input into output in the same format
+    Statistics sort(std::istream& input, std::ostream& output, const ChunkSorter& sortChunk) {
+        Statistics statistics;
+        if (!(input >> statistics.elements)) {
+            throw std::runtime_error("Failed to read size from external sort input");
+        }
+
+        // Small inputs skip the temporary files
+        if (statistics.elements <= chunkCapacity()) {
+            DynamicArray<T> chunk(std::max<size_t>(statistics.elements, 1), resource);
+            readText(input, chunk, statistics.elements);
+            sortChunk(&chunk);
+            output << statistics.elements << '\n';
+            writeText(output, chunk.data(), chunk.getSize());
+            checkOutput(output);
+            return statistics;
+        }
+
+        std::vector<Run> runs = createRuns(input, statistics.elements, sortChunk);
+        statistics.runs = runs.size();
+
+        // Intermediate passes merge groups of runs into longer runs until
+        // the last pass can take all of them
+        size_t fanIn = maxFanIn();
+        while (runs.size() > fanIn) {
+            std::vector<Run> merged;
+            for (size_t first = 0; first < runs.size(); first += fanIn) {
+                std::vector<Run> group(runs.begin() + first, runs.begin() + std::min(first + fanIn, runs.size()));
+                merged.push_back(mergeToRun(group));
+                removeRuns(group);
+            }
+            runs = std::move(merged);
+            statistics.mergePasses++;
+        }
+
+        output << statistics.elements << '\n';
+        BlockWriter writer(blockCapacity(runs.size()), [&output](const T* values, size_t count) {
+            writeText(output, values, count);
+        });
+        merge(runs, writer);
+        checkOutput(output);
+        removeRuns(runs);
+        statistics.mergePasses++;
+        return statistics;
+    }
+
+private:
+    // Smaller blocks turn the merge into random I/O across the runs
+    static constexpr size_t minimumBlockBytes = 1 << 16;
+
+    struct FileCloser {
+        void operator()(std::FILE* file) const {
+            std::fclose(file);
+        }
+    };
+    using File = std::unique_ptr<std::FILE, FileCloser>;
+
+    // Sorted run spilled to a temporary binary file of raw elements
+    struct Run {
+        std::filesystem::path path;
+        size_t length;
+    };
+
+    // Sequential reader of a run: while the current block is consumed the
+    // next one is already being read on another thread
+    class RunReader {
+    public:
+        RunReader(const Run& run, size_t blockElements)
+                : file(openFile(run.path, "rb")), remaining(run.length), current(blockElements), next(blockElements) {
+            startRead();
+            nextBlock();
+        }
+
+        RunReader(const RunReader&) = delete;
+        RunReader& operator=(const RunReader&) = delete;
+
+        bool exhausted() const {
+            return position == available;
+        }
+
+        const T& value() const {
+            return current[position];
+        }
+
+        void pop() {
+            if (++position == available) {
+                nextBlock();
+            }
+        }
+
+    private:
+        File file;
+        size_t remaining;          // Elements not yet requested from the file
+        std::vector<T> current;
+        std::vector<T> next;       // Target of the read in flight
+        size_t position = 0;
+        size_t available = 0;
+        std::future<size_t> pending;
+
+        void startRead() {
+            size_t count = std::min(remaining, next.size());
+            remaining -= count;
+            pending = std::async(std::launch::async, [this, count] {
+                if (std::fread(next.data(), sizeof(T), count, file.get()) != count) {
+                    throw std::runtime_error("Short read from temporary run file");
+                }
+                return count;
+            });
+        }
+
+        void nextBlock() {
+            available = pending.valid() ? pending.get() : 0;
+            position = 0;
+            std::swap(current, next);
+            if (available > 0 && remaining > 0) {
+                startRead();
+            }
+        }
+    };
+
+    // Output buffer: a full block is flushed on another thread while the
+    // next one fills, with at most one flush in flight so the order is kept
+    class BlockWriter {
+    public:
+        using Flush = std::function<void(const T*, size_t)>;
+
+        BlockWriter(size_t blockElements, Flush flush)
+                : current(blockElements), next(blockElements), flush(std::move(flush)) {}
+
+        BlockWriter(const BlockWriter&) = delete;
+        BlockWriter& operator=(const BlockWriter&) = delete;
+
+        void push(const T& value) {
+            current[count++] = value;
+            if (count == current.size()) {
+                flushBlock();
+            }
+        }
+
+        // Flush the partial block and wait for every write
+        void finish() {
+            if (count > 0) {
+                flushBlock();
+            }
+            if (pending.valid()) {
+                pending.get();
+            }
+        }
+
+    private:
+        std::vector<T> current;
+        std::vector<T> next;       // Block being flushed
+        size_t count = 0;
+        Flush flush;
+        std::future<void> pending;
+
+        void flushBlock() {
+            if (pending.valid()) {
+                pending.get();
+            }
+            std::swap(current, next);
+            size_t full = count;
+            count = 0;
+            pending = std::async(std::launch::async, [this, full] { flush(next.data(), full); });
+        }
+    };
+
+    // Tournament tree over the run readers. Internal nodes keep the loser of
+    // their match, so after the winner advances only the log2(k) matches on
+    // its path to the root are replayed, one comparison each
+    class LoserTree {
+    public:
+        explicit LoserTree(const std::vector<std::unique_ptr<RunReader>>& readers)
+                : readers(readers), tree(std::max<size_t>(readers.size(), 1)) {
+            tree[0] = build(1);
+        }
+
+        size_t winner() const {
+            return tree[0];
+        }
+
+        // Replay the matches of a leaf whose reader has advanced
+        void replay(size_t leaf) {
+            size_t winner = leaf;
+            for (size_t node = (leaf + readers.size()) / 2; node > 0; node /= 2) {
+                if (beats(tree[node], winner)) {
+                    std::swap(tree[node], winner);
+                }
+            }
+            tree[0] = winner;
+        }
+
+    private:
+        const std::vector<std::unique_ptr<RunReader>>& readers;
+        std::vector<size_t> tree; // tree[0] is the overall winner, tree[1, k) the losers; leaf i is node k + i
+
+        // Exhausted readers lose every match; equal keys go to the earlier run
+        bool beats(size_t a, size_t b) const {
+            if (readers[a]->exhausted()) return false;
+            if (readers[b]->exhausted()) return true;
+            const T& x = readers[a]->value();
+            const T& y = readers[b]->value();
+            return x < y || (!(y < x) && a < b);
+        }
+
+        size_t build(size_t node) {
+            size_t k = readers.size();
+            if (node >= k) {
+                return node - k;
+            }
+            size_t left = build(2 * node);
+            size_t right = build(2 * node + 1);
+            if (beats(right, left)) {
+                tree[node] = left;
+                return right;
+            }
+            tree[node] = right;
+            return left;
+        }
+    };
+
+    size_t memoryBudget;
+    std::filesystem::path tempDirectory;
+    MemoryResource* resource;
+    std::string prefix;                      // Keeps run files of concurrent processes apart
+    std::vector<std::filesystem::path> created;
+
+    static File openFile(const std::filesystem::path& path, const char* mode) {
+        File file(std::fopen(path.c_str(), mode));
+        if (!file) {
+            throw std::runtime_error("Unable to open temporary file: " + path.string());
+        }
+        return file;
+    }
+
+    // Elements per buffer when merging k runs: two blocks per run and two for the output
+    size_t blockCapacity(size_t k) const {
+        return std::max<size_t>(memoryBudget / ((2 * k + 2) * sizeof(T)), 1);
+    }
+
+    Run newRun(size_t length) {
+        Run run = {tempDirectory / (prefix + std::to_string(created.size()) + ".run"), length};
+        created.push_back(run.path);
+        return run;
+    }
+
+    static void removeRuns(const std::vector<Run>& runs) {
+        for (const Run& run : runs) {
+            std::error_code ignored;
+            std::filesystem::remove(run.path, ignored);
+        }
+    }
+
+    static void readText(std::istream& input, DynamicArray<T>& chunk, size_t count) {
+        T* values = chunk.uninitializedTail(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (!(input >> values[i])) {
+                throw std::runtime_error("Failed to read value from external sort input");
+            }
+        }
+        chunk.commit(count);
+    }
+
+    static void writeText(std::ostream& output, const T* values, size_t count) {
+        std::ostringstream text;
+        for (size_t i = 0; i < count; ++i) {
+            text << values[i] << '\n';
+        }
+        output << text.str();
+    }
+
+    static void writeBinary(std::FILE* file, const T* values, size_t count) {
+        if (std::fwrite(values, sizeof(T), count, file) != count) {
+            throw std::runtime_error("Failed to write temporary run file");
+        }
+    }
+
+    static void checkOutput(std::ostream& output) {
+        if (!output.flush()) {
+            throw std::runtime_error("Failed to write external sort output");
+        }
+    }
+
+    // Read, sort and spill chunks; a chunk is written on another thread while
+    // the next one is parsed and sorted in the other buffer
+    std::vector<Run> createRuns(std::istream& input, size_t total, const ChunkSorter& sortChunk) {
+        size_t capacity = chunkCapacity();
+        DynamicArray<T> chunks[2] = {DynamicArray<T>(capacity, resource), DynamicArray<T>(capacity, resource)};
+        std::vector<Run> runs;
+        std::future<void> pendingWrite;
+
+        size_t remaining = total;
+        for (size_t index = 0; remaining > 0; index ^= 1) {
+            DynamicArray<T>& chunk = chunks[index];
+            size_t count = std::min(remaining, capacity);
+            chunk.clear();
+            readText(input, chunk, count);
+            remaining -= count;
+            sortChunk(&chunk);
+
+            if (pendingWrite.valid()) {
+                pendingWrite.get();
+            }
+            runs.push_back(newRun(count));
+            pendingWrite = std::async(std::launch::async, [&chunk, path = runs.back().path] {
+                File file = openFile(path, "wb");
+                writeBinary(file.get(), chunk.data(), chunk.getSize());
+            });
+        }
+        if (pendingWrite.valid()) {
+            pendingWrite.get();
+        }
+        return runs;
+    }
+
+    // Merge a group of runs into one new run
+    Run mergeToRun(const std::vector<Run>& group) {
+        size_t length = 0;
+        for (const Run& run : group) {
+            length += run.length;
+        }
+        Run merged = newRun(length);
+        File file = openFile(merged.path, "wb");
+        std::FILE* target = file.get();
+        BlockWriter writer(blockCapacity(group.size()), [target](const T* values, size_t count) {
+            writeBinary(target, values, count);
+        });
+        merge(group, writer);
+        return merged;
+    }
+
+    // k-way merge of the runs into the writer
+    void merge(const std::vector<Run>& runs, BlockWriter& writer) {
+        size_t block = blockCapacity(runs.size());
+        std::vector<std::unique_ptr<RunReader>> readers;
+        for (const Run& run : runs) {
+            readers.push_back(std::make_unique<RunReader>(run, block));
+        }
+
+        LoserTree tree(readers);
+        while (!readers[tree.winner()]->exhausted()) {
+            size_t winner = tree.winner();
+            writer.push(readers[winner]->value());
+            readers[winner]->pop();
+            tree.replay(winner);
+        }
+        writer.finish();
+    }
+};
+
+#endif // AIZOPROJEKT_EXTERNALSORTER_H
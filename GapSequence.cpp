@@ -0,0 +1 @@
+#include "GapSequence.h"
@@ -0,0 +1,98 @@
+#ifndef AIZOPROJEKT_GAPSEQUENCE_H
+#define AIZOPROJEKT_GAPSEQUENCE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Gap sequences for Shell Sort
+enum class GapSequence {
+    Shell,     // n/2, n/4, ..., 1 (Shell 1959), O(n^2) worst case
+    Knuth,     // (3^k - 1) / 2 below n/3: 1, 4, 13, 40, ... (Knuth 1973), O(n^1.5)
+    Sedgewick, // 1, then 4^k + 3 * 2^(k-1) + 1: 8, 23, 77, ... (Sedgewick 1982), O(n^4/3)
+    Pratt,     // Every 2^p * 3^q (Pratt 1971), O(n log^2 n) but many passes
+    Ciura,     // 1, 4, 10, 23, 57, 132, 301, 701, 1750, then * 2.25 (Ciura 2001, empirical)
+    Tokuda     // ceil((9 * 2.25^(k-1) - 4) / 5): 1, 4, 9, 20, 46, ... (Tokuda 1992)
+};
+
+class GapSequences {
+public:
+    // Sequence selected by --gaps
+    static GapSequence byName(const std::string& name) {
+        static const std::unordered_map<std::string, GapSequence> sequences = {
+                {"shell", GapSequence::Shell},
+                {"knuth", GapSequence::Knuth},
+                {"sedgewick", GapSequence::Sedgewick},
+                {"pratt", GapSequence::Pratt},
+                {"ciura", GapSequence::Ciura},
+                {"tokuda", GapSequence::Tokuda}
+        };
+        auto found = sequences.find(name);
+        if (found == sequences.end()) {
+            throw std::invalid_argument("Unknown gap sequence: " + name + " (use shell, knuth, sedgewick, pratt, ciura or tokuda)");
+        }
+        return found->second;
+    }
+
+    // Gaps below n in the order Shell Sort uses them (largest first, ending with 1)
+    static std::vector<size_t> forSize(GapSequence sequence, size_t n) {
+        std::vector<size_t> gaps;
+        if (n < 2) {
+            return gaps;
+        }
+        switch (sequence) {
+            case GapSequence::Shell:
+                for (size_t gap = n / 2; gap > 0; gap /= 2) {
+                    gaps.push_back(gap);
+                }
+                return gaps; // Already largest first
+            case GapSequence::Knuth:
+                for (size_t gap = 1; gap == 1 || gap < n / 3; gap = 3 * gap + 1) {
+                    gaps.push_back(gap);
+                }
+                break;
+            case GapSequence::Sedgewick:
+                gaps.push_back(1);
+                for (size_t k = 1;; k++) {
+                    size_t gap = (size_t(1) << (2 * k)) + 3 * (size_t(1) << (k - 1)) + 1;
+                    if (gap >= n) break;
+                    gaps.push_back(gap);
+                }
+                break;
+            case GapSequence::Pratt:
+                for (size_t power2 = 1; power2 < n; power2 *= 2) {
+                    for (size_t gap = power2; gap < n; gap *= 3) {
+                        gaps.push_back(gap);
+                    }
+                }
+                std::sort(gaps.begin(), gaps.end());
+                break;
+            case GapSequence::Ciura: {
+                static const size_t measured[] = {1, 4, 10, 23, 57, 132, 301, 701, 1750};
+                for (size_t gap : measured) {
+                    if (gap >= n) break;
+                    gaps.push_back(gap);
+                }
+                for (double gap = 1750 * 2.25; gap < n; gap *= 2.25) {
+                    gaps.push_back(static_cast<size_t>(gap));
+                }
+                break;
+            }
+            case GapSequence::Tokuda:
+                for (double power = 1;; power *= 2.25) {
+                    auto gap = static_cast<size_t>(std::ceil((9 * power - 4) / 5));
+                    if (gap >= n) break;
+                    gaps.push_back(gap);
+                }
+                break;
+        }
+        std::reverse(gaps.begin(), gaps.end());
+        return gaps;
+    }
+};
+
+#endif // AIZOPROJEKT_GAPSEQUENCE_H
@@ -1,6 +1,7 @@
 #ifndef AIZOPROJEKT_HELPER_H
 #define AIZOPROJEKT_HELPER_H
 
+#include <algorithm>
 #include <string>
 #include <stdexcept>
 #include <filesystem>
@@ -8,9 +9,15 @@
 #include <iostream>
 #include <unordered_map>
 #include <functional>
+#include <map>
+#include <tuple>
 #include <valarray>
+#include <vector>
 #include "DynamicArray.h"
+#include "ExternalSorter.h"
 #include "ArgumentParser.h"
+#include "MemoryTracker.h"
+#include "PerfCounter.h"
 #include "Sorter.h"
 #include "Timer.h"
 
@@ -23,7 +30,10 @@ public:
                 {Mode::FILE_TEST, fileTest},
                 {Mode::BENCHMARK, benchmark},
                 {Mode::DRUNK, drunk},
-                {Mode::RUN_TESTS, runTests}
+                {Mode::RUN_TESTS, runTests},
+                {Mode::MAPPED, mappedSort},
+                {Mode::SELECT, select},
+                {Mode::EXTERNAL, externalSort}
         };
 
         auto handler = modeHandlers.find(args.mode);
@@ -35,6 +45,17 @@ public:
     }
 
 private:
+    // Cases run by one RUN_TESTS option; iterations 0 keeps --iterations
+    struct TestSuite {
+        std::vector<int> algorithms;
+        std::vector<int> dataTypes;
+        std::vector<size_t> sizes;
+        std::vector<int> distributions;
+        int iterations = 0;
+        int baseline = -1; // Algorithm the others are compared against (speedup), -1 for none
+        std::vector<std::string> gapSequences = {}; // Shell Sort gap sequences to run, empty keeps --gaps
+    };
+
     // Type definitions to simplify code
     using IntSorter = std::function<void(DynamicArray<int>*)>;
     using FloatSorter = std::function<void(DynamicArray<float>*)>;
@@ -42,7 +63,7 @@ private:
 
     // Template function to read data from file
     template <typename T>
-    static DynamicArray<T>* readDataFromFile(const std::string& filename) {
+    static DynamicArray<T>* readDataFromFile(const std::string& filename, MemoryResource* resource = MemoryResource::heap()) {
         std::filesystem::path originalPath = std::filesystem::current_path();
 
         try {
@@ -53,19 +74,20 @@ private:
                 throw std::runtime_error("Unable to open input file: " + filename);
             }
 
-            int size;
+            size_t size;
             if (!(inputFile >> size)) {
                 throw std::runtime_error("Failed to read size from input file: " + filename);
             }
 
-            auto* data = new DynamicArray<T>(size);
-            for (int i = 0; i < size; ++i) {
-                T value;
-                if (!(inputFile >> value)) {
+            auto* data = new DynamicArray<T>(size, resource);
+            T* values = data->uninitializedTail(size);
+            for (size_t i = 0; i < size; ++i) {
+                if (!(inputFile >> values[i])) {
+                    delete data;
                     throw std::runtime_error("Failed to read value from input file: " + filename);
                 }
-                data->insert(i, value);
             }
+            data->commit(size);
 
             std::filesystem::current_path(originalPath);
             std::cout << "Data read from file: " << filename << std::endl;
@@ -101,7 +123,8 @@ private:
                 {1, generateTestDataDescending<T>}, // Descending
                 {2, generateTestDataAscending<T>}, // Ascending
                 {3, generateTestData_33<T>}, // 33% Sorted
-                {4, generateTestData_66<T>} // 66% Sorted
+                {4, generateTestData_66<T>}, // 66% Sorted
+                {5, generateTestDataFewUnique<T>} // Few unique keys
         };
 
         auto generator = generators.find(args.distribution);
@@ -112,21 +135,30 @@ private:
         }
     }
 
+    // Fill count slots with random values of the given data type
+    template <typename T>
+    static void fillRandom(T* values, size_t count, int dataType) {
+        for (size_t i = 0; i < count; ++i) {
+            if (dataType == 0) { // int
+                values[i] = rand() % (std::numeric_limits<int>::max());
+            } else if (dataType == 1) { // float
+                values[i] = (float)(rand()) / (float)(rand());
+            } else { // char
+                values[i] = (char) rand() % 256;
+            }
+        }
+    }
+
     // Basic random data generator
     template <typename T>
     static DynamicArray<T>* generateTestData(const Arguments& args) {
-        auto* data = new DynamicArray<T>(args.size);
-        for (int i = 0; i < args.size; ++i) {
-            if (args.dataType == 0) { // int
-                data->insert(i, rand() % (std::numeric_limits<int>::max()));
-            } else if (args.dataType == 1) { // float
-                data->insert(i, (float)(rand()) / (float)(rand()));
-            } else if (args.dataType == 2) { // char
-                data->insert(i, (char) rand() % 256);
-            } else {
-                throw std::invalid_argument("Invalid data type");
-            }
+        if (args.dataType < 0 || args.dataType > 2) {
+            throw std::invalid_argument("Invalid data type");
         }
+
+        auto* data = new DynamicArray<T>(args.size, MemoryResource::byName(args.allocator));
+        fillRandom(data->uninitializedTail(args.size), args.size, args.dataType);
+        data->commit(args.size);
         std::cout << "Test data generated with size: " << args.size << std::endl;
         //writeDataToFile("before.txt", data);
         return data;
@@ -136,7 +168,7 @@ private:
     template<typename T>
     static DynamicArray<T>* generateTestDataDescending(const Arguments& args) {
         auto* data = generateTestData<T>(args);
-        Sorter<T>::quickSortDesc(data, 0, data->getSize() - 1);
+        Sorter<T>::quickSortDesc(data, 0, (ptrdiff_t) data->getSize() - 1);
         std::cout << "Test data generated in descending order with size: " << args.size << std::endl;
         writeDataToFile("before.txt", data);
         return data;
@@ -146,7 +178,7 @@ private:
     template<typename T>
     static DynamicArray<T>* generateTestDataAscending(const Arguments& args) {
         auto* data = generateTestData<T>(args);
-        Sorter<T>::quickSort(data, 0, data->getSize() - 1);
+        Sorter<T>::quickSort(data);
         std::cout << "Test data generated in ascending order with size: " << args.size << std::endl;
         writeDataToFile("before.txt", data);
         return data;
@@ -157,8 +189,8 @@ private:
     static DynamicArray<T>* generateTestData_33(const Arguments& args) {
         auto* data = generateTestData<T>(args);
         size_t oneThirdSize = data->getSize() / 3;
-        Sorter<T>::quickSort(data, 0, oneThirdSize);
-        Sorter<T>::quickSortDesc(data, oneThirdSize + 1, data->getSize() - 1);
+        Sorter<T>::quickSort(data, 0, (ptrdiff_t) oneThirdSize);
+        Sorter<T>::quickSortDesc(data, (ptrdiff_t) oneThirdSize + 1, (ptrdiff_t) data->getSize() - 1);
         std::cout << "Test data generated with 33% sorted with size: " << args.size << std::endl;
         //writeDataToFile("before.txt", data);
         return data;
@@ -169,42 +201,117 @@ private:
     static DynamicArray<T>* generateTestData_66(const Arguments& args) {
         auto* data = generateTestData<T>(args);
         size_t twoThirdSize = data->getSize() * 2 / 3;
-        Sorter<T>::quickSort(data, 0, twoThirdSize);
-        Sorter<T>::quickSortDesc(data, twoThirdSize + 1, data->getSize() - 1);
+        Sorter<T>::quickSort(data, 0, (ptrdiff_t) twoThirdSize);
+        Sorter<T>::quickSortDesc(data, (ptrdiff_t) twoThirdSize + 1, (ptrdiff_t) data->getSize() - 1);
         std::cout << "Test data generated with 66% sorted with size: " << args.size << std::endl;
         //writeDataToFile("before.txt", data);
         return data;
     }
 
-    // Execute sort algorithm based on type and algorithm choice
+    // Every element is one of fewUniqueKeys distinct values (0, 1, 2, ...)
+    static constexpr int fewUniqueKeys = 16;
+
     template <typename T>
-    static void executeSort(DynamicArray<T>* data, int algorithmChoice, Timer& timer) {
+    static DynamicArray<T>* generateTestDataFewUnique(const Arguments& args) {
+        if (args.dataType < 0 || args.dataType > 2) {
+            throw std::invalid_argument("Invalid data type");
+        }
+
+        auto* data = new DynamicArray<T>(args.size, MemoryResource::byName(args.allocator));
+        T* values = data->uninitializedTail(args.size);
+        for (size_t i = 0; i < args.size; ++i) {
+            values[i] = static_cast<T>(rand() % fewUniqueKeys);
+        }
+        data->commit(args.size);
+        std::cout << "Test data generated with " << fewUniqueKeys << " unique keys with size: " << args.size << std::endl;
+        return data;
+    }
+
+    template <typename T>
+    using SortFunction = std::function<void(DynamicArray<T>*, const Arguments&)>;
+
+    // Implementation of a sorting algorithm id
+    template <typename T>
+    static const SortFunction<T>& sortFunction(int algorithm) {
         // Map sorting algorithms to their implementations
-        static const std::unordered_map<int, std::function<void(DynamicArray<T>*)>> sorters = {
-                {0, [](DynamicArray<T>* d) { Sorter<T>::bubbleSort(d); }},
-                {1, [](DynamicArray<T>* d) { Sorter<T>::mergeSort(d); }},
-                {2, [](DynamicArray<T>* d) { Sorter<T>::insertSort(d); }},
-                {3, [](DynamicArray<T>* d) { Sorter<T>::binaryInsertSort(d); }},
-                {5, [](DynamicArray<T>* d) { Sorter<T>::heapSort(d); }},
-                {6, [](DynamicArray<T>* d) { Sorter<T>::shellSort(d); }}
+        static const std::unordered_map<int, SortFunction<T>> sorters = {
+                {0, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::bubbleSort(d); }},
+                {1, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::mergeSort(d); }},
+                {2, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::insertSort(d); }},
+                {3, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::binaryInsertSort(d); }},
+                {4, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::quickSort(d); }},
+                {5, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::heapSort(d); }},
+                {6, [](DynamicArray<T>* d, const Arguments& a) {
+                    Sorter<T>::shellSort(d, GapSequences::byName(a.gapSequence));
+                }},
+                {7, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::introSort(d); }},
+                {8, [](DynamicArray<T>* d, const Arguments& a) {
+                    Sorter<T>::parallelQuickSort(d, ThreadPool::shared(a.threads));
+                }},
+                {9, [](DynamicArray<T>* d, const Arguments& a) {
+                    Sorter<T>::parallelMergeSort(d, ThreadPool::shared(a.threads));
+                }},
+                {10, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::pingPongMergeSort(d); }},
+                {11, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::bottomUpMergeSort(d); }},
+                {12, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::lsdRadixSort(d); }},
+                {13, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::americanFlagSort(d); }},
+                {14, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::countingSort(d); }},
+                {15, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::autoSort(d); }},
+                {16, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::simdMergeSort(d); }},
+                {17, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::vectorQuickSort(d); }},
+                {18, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::blockQuickSort(d); }},
+                {19, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::powerSort(d); }},
+                {20, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::template dAryHeapSort<4>(d); }},
+                {21, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::template dAryHeapSort<8>(d); }},
+                {22, [](DynamicArray<T>* d, const Arguments&) { Sorter<T>::threeWayQuickSort(d); }},
+                {23, [](DynamicArray<T>* d, const Arguments& a) {
+                    Sorter<T>::dualPivotQuickSort(d, a.lowPivotRank, a.highPivotRank, a.insertionCutoff);
+                }},
+                {24, [](DynamicArray<T>* d, const Arguments& a) {
+                    const SortFunction<T>& bucketSort = sortFunction<T>(a.bucketAlgorithm);
+                    Sorter<T>::parallelSampleSort(d, ThreadPool::shared(a.threads), [&bucketSort, &a](DynamicArray<T>* bucket) {
+                        bucketSort(bucket, a);
+                    }, a.sampleSeed);
+                }}
         };
 
-        // Special case for Quick Sort which needs start/end indices
-        if (algorithmChoice == 4) {
-            timer.start();
-            Sorter<T>::quickSort(data, 0, data->getSize() - 1);
-            timer.stop();
-            return;
+        auto sorter = sorters.find(algorithm);
+        if (sorter == sorters.end()) {
+            throw std::invalid_argument("Invalid algorithm choice");
         }
+        return sorter->second;
+    }
 
-        auto sorter = sorters.find(algorithmChoice);
-        if (sorter != sorters.end()) {
-            timer.start();
-            sorter->second(data);
-            timer.stop();
-        } else {
-            throw std::invalid_argument("Invalid algorithm choice");
+    // Execute sort algorithm based on type and algorithm choice
+    template <typename T>
+    static void executeSort(DynamicArray<T>* data, const Arguments& args, Timer& timer,
+                            PerfCounter* branchMisses = nullptr) {
+        const SortFunction<T>& sorter = sortFunction<T>(args.algorithm);
+        if (isParallel(args.algorithm)) {
+            ThreadPool::shared(args.threads); // Start the workers outside the timed region
+        }
+        if (args.algorithm == 24 && isParallel(args.bucketAlgorithm)) {
+            throw std::invalid_argument("--bucket-sort must be a sequential algorithm");
         }
+        MemoryTracker::reset();
+        if (branchMisses) branchMisses->start();
+        timer.start();
+        sorter(data, args);
+        timer.stop();
+        if (branchMisses) branchMisses->stop();
+    }
+
+    // Algorithms that run on the shared thread pool
+    static bool isParallel(int algorithm) {
+        return algorithm == 8 || algorithm == 9 || algorithm == 24;
+    }
+
+    // Threads an algorithm actually uses, as recorded in the results
+    static size_t threadsUsed(const Arguments& args) {
+        if (!isParallel(args.algorithm)) {
+            return 1;
+        }
+        return ThreadPool::shared(args.threads).size();
     }
 
     // Execute drunk sort algorithm
@@ -216,7 +323,7 @@ private:
             timer.stop();
         } else if (algorithmChoice == 1) { // Quick Sort Drunk
             timer.start();
-            Sorter<T>::drunkQuickSort(data, 0, data->getSize() - 1, drunkLevel);
+            Sorter<T>::drunkQuickSort(data, 0, (ptrdiff_t) data->getSize() - 1, drunkLevel);
             timer.stop();
         } else {
             throw std::invalid_argument("Invalid algorithm choice for DRUNK mode");
@@ -227,13 +334,151 @@ private:
     template <typename T>
     static void executeFileTest(const Arguments& args) {
         Timer dummyTimer; // Timer not used but needed for API consistency
-        auto* data = readDataFromFile<T>(args.inputFile);
-        executeSort<T>(data, args.algorithm, dummyTimer);
+        auto* data = readDataFromFile<T>(args.inputFile, MemoryResource::byName(args.allocator));
+        executeSort<T>(data, args, dummyTimer);
         writeDataToFile(args.outputFile, data);
         Sorter<T>::isCorrect(data);
         delete data;
     }
 
+    // Mapped file executor: sorts a binary file in place through a shared mapping
+    template <typename T>
+    static void executeMappedSort(const Arguments& args) {
+        bool generate = args.size > 0;
+        MappedFileResource file(args.inputFile, generate);
+        size_t count = generate ? args.size : file.length() / sizeof(T);
+        if (count == 0) {
+            throw std::runtime_error("No data in mapped file: " + args.inputFile);
+        }
+
+        // The mapping already holds the file contents, commit adopts them as elements
+        DynamicArray<T> data(count, &file);
+        T* values = data.uninitializedTail(count);
+        if (generate) {
+            fillRandom(values, count, args.dataType);
+            std::cout << "Test data generated in mapped file with size: " << count << std::endl;
+        }
+        data.commit(count);
+
+        Timer timer;
+        executeSort<T>(&data, args, timer);
+        std::cout << "Sorting completed in " << timer.result() << " ms." << std::endl;
+        Sorter<T>::isCorrect(&data);
+        std::cout << "Sorted data left in mapped file: " << args.inputFile << std::endl;
+    }
+
+    // Selection executor: nth element, partial sort or top-k of a file
+    template <typename T>
+    static void executeSelect(const Arguments& args) {
+        auto* data = readDataFromFile<T>(args.inputFile, MemoryResource::byName(args.allocator));
+        DynamicArray<T> result(std::max<size_t>(std::min(args.rank, data->getSize()), 1));
+        Timer timer;
+
+        try {
+            if (args.selection == "nth") {
+                timer.start();
+                Sorter<T>::nthElement(data, args.rank);
+                timer.stop();
+                std::cout << "Element of rank " << args.rank << ": " << data->get(args.rank) << std::endl;
+                result.add(data->get(args.rank));
+            } else if (args.selection == "partial") {
+                timer.start();
+                Sorter<T>::partialSort(data, args.rank);
+                timer.stop();
+                result.appendRange(data->data(), std::min(args.rank, data->getSize()));
+            } else if (args.selection == "topk") {
+                timer.start();
+                Sorter<T>::topK(data, args.rank, &result);
+                timer.stop();
+            } else {
+                throw std::invalid_argument("Invalid selection: " + args.selection + " (use nth, partial or topk)");
+            }
+        } catch (...) {
+            delete data;
+            throw;
+        }
+        std::cout << "Selection completed in " << timer.result() << " ms." << std::endl;
+
+        if (!args.outputFile.empty()) {
+            writeDataToFile(args.outputFile, args.selection == "nth" ? data : &result);
+        } else if (args.selection != "nth") {
+            for (size_t i = 0; i < result.getSize(); ++i) {
+                std::cout << result[i] << std::endl;
+            }
+        }
+        delete data;
+    }
+
+    // External sort executor: streams the file through memory-budgeted runs
+    template <typename T>
+    static void executeExternalSort(const Arguments& args) {
+        // Relative input paths are resolved against the parent directory, like readDataFromFile
+        std::filesystem::path inputPath = std::filesystem::current_path().parent_path() / args.inputFile;
+        std::ifstream input(inputPath);
+        if (!input) {
+            throw std::runtime_error("Unable to open input file: " + args.inputFile);
+        }
+        std::ofstream output(args.outputFile);
+        if (!output) {
+            throw std::runtime_error("Unable to open output file: " + args.outputFile);
+        }
+        std::filesystem::path tempDirectory = args.tempDirectory.empty()
+                ? std::filesystem::temp_directory_path() : std::filesystem::path(args.tempDirectory);
+
+        ExternalSorter<T> sorter(args.memoryBudget << 20, tempDirectory, MemoryResource::byName(args.allocator));
+        Timer timer;
+        timer.start();
+        auto statistics = sorter.sort(input, output, [&args](DynamicArray<T>* chunk) {
+            Timer chunkTimer;
+            executeSort<T>(chunk, args, chunkTimer);
+        });
+        timer.stop();
+
+        std::cout << "External sort of " << statistics.elements << " elements completed in " << timer.result() << " ms ("
+                  << statistics.runs << " runs of up to " << sorter.chunkCapacity() << " elements, "
+                  << statistics.mergePasses << " merge passes, fan-in " << sorter.maxFanIn() << ")." << std::endl;
+        std::cout << "Data written to file: " << args.outputFile << std::endl;
+    }
+
+    // External sort handler
+    static void externalSort(Arguments& args) {
+        if (args.dataType == 0) { // int
+            executeExternalSort<int>(args);
+        } else if (args.dataType == 1) { // float
+            executeExternalSort<float>(args);
+        } else if (args.dataType == 2) { // char
+            executeExternalSort<char>(args);
+        } else {
+            throw std::invalid_argument("Invalid data type");
+        }
+    }
+
+    // Selection handler
+    static void select(Arguments& args) {
+        if (args.dataType == 0) { // int
+            executeSelect<int>(args);
+        } else if (args.dataType == 1) { // float
+            executeSelect<float>(args);
+        } else if (args.dataType == 2) { // char
+            executeSelect<char>(args);
+        } else {
+            throw std::invalid_argument("Invalid data type");
+        }
+    }
+
+    // Mapped file handler
+    static void mappedSort(Arguments& args) {
+        if (args.dataType == 0) { // int
+            executeMappedSort<int>(args);
+        } else if (args.dataType == 1) { // float
+            executeMappedSort<float>(args);
+        } else if (args.dataType == 2) { // char
+            executeMappedSort<char>(args);
+        } else {
+            throw std::invalid_argument("Invalid data type");
+        }
+    }
+
     // File test handler
     static void fileTest(Arguments& args) {
         if (args.dataType == 0) { // int
@@ -248,16 +493,21 @@ private:
         }
     }
 
-    // Benchmark handler
-    static void benchmark(Arguments& args) {
+    // Benchmark handler, returns the average time in ms
+    static double benchmark(Arguments& args) {
         Timer timer;
-        DynamicArray<int>* times = new DynamicArray<int>(100);
+        DynamicArray<long long>* times = new DynamicArray<long long>(args.iterations);
+        size_t peakMemory = 0; // Largest scratch allocation of any iteration
+        PerfCounter branchMisses(PerfCounter::Event::BranchMisses); // Of the sorting thread only
+        long long totalBranchMisses = 0;
 
-        for(int i = 0; i < 100; i++) {
+        for(int i = 0; i < args.iterations; i++) {
             if (args.dataType == 0) { // int
                 auto* data = generateData<int>(args);
                 try {
-                    executeSort<int>(data, args.algorithm, timer);
+                    executeSort<int>(data, args, timer, &branchMisses);
+                    peakMemory = std::max(peakMemory, MemoryTracker::peak());
+                    totalBranchMisses += branchMisses.result();
                     std::cout << "Sorting completed in " << timer.result() << " ms." << std::endl;
                     Sorter<int>::isCorrect(data);
                     times->add(timer.result());
@@ -269,7 +519,9 @@ private:
             } else if (args.dataType == 1) { // float
                 auto* data = generateData<float>(args);
                 try {
-                    executeSort<float>(data, args.algorithm, timer);
+                    executeSort<float>(data, args, timer, &branchMisses);
+                    peakMemory = std::max(peakMemory, MemoryTracker::peak());
+                    totalBranchMisses += branchMisses.result();
                     std::cout << "Sorting completed in " << timer.result() << " ms." << std::endl;
                     Sorter<float>::isCorrect(data);
                     times->add(timer.result());
@@ -282,7 +534,9 @@ private:
             else if (args.dataType == 2) { // char
                 auto* data = generateData<char>(args);
                 try {
-                    executeSort<char>(data, args.algorithm, timer);
+                    executeSort<char>(data, args, timer, &branchMisses);
+                    peakMemory = std::max(peakMemory, MemoryTracker::peak());
+                    totalBranchMisses += branchMisses.result();
                     std::cout << "Sorting completed in " << timer.result() << " ms." << std::endl;
                     Sorter<char>::isCorrect(data);
                     times->add(timer.result());
@@ -296,18 +550,31 @@ private:
             }
         }
 
+        double avgTime = 0;
+        for (long long time : *times) {
+            avgTime += time;
+        }
+        avgTime /= times->getSize();
+        std::cout << "Peak scratch memory: " << peakMemory << " bytes." << std::endl;
+        long long avgBranchMisses = -1;
+        if (branchMisses.available()) {
+            avgBranchMisses = totalBranchMisses / (long long) times->getSize();
+            std::cout << "Average branch misses: " << avgBranchMisses << std::endl;
+        }
+
         if (!args.outputFile.empty()) {
-            writeDataToExcel(args.outputFile, times, args);
+            writeDataToExcel(args.outputFile, times, args, peakMemory, avgBranchMisses);
         }
         delete times;
+        return avgTime;
     }
 
     // Drunk sort handler
     static void drunk(Arguments& args) {
         Timer timer;
-        DynamicArray<int>* times = new DynamicArray<int>(100);
+        DynamicArray<long long>* times = new DynamicArray<long long>(args.iterations);
 
-        for (int i = 0; i < 100; i++) {
+        for (int i = 0; i < args.iterations; i++) {
             if (args.dataType == 0) { // int
                 auto* data = generateData<int>(args);
                 try {
@@ -357,30 +624,80 @@ private:
     static void runTests(Arguments& args) {
         std::cout << "Running tests..." << std::endl;
 
-        //int algorithms[] = {0, 1, 2, 3, 4, 5}; // Bubble, Merge, Insert, Binary Insert, Quick, Heap
-        int algorithms[] = {2}; // Reduced for testing
-        int dataTypes[] = {0, 1, 2}; // int, float, char
-        int sizes[] = {10000, 20000, 30000, 40000, 50000};
-        int distributions[] = {0, 1, 2, 3, 4}; // Random, Descending, Ascending, 33%, 66%
-
-        for (int algorithm : algorithms) {
-            for (int dataType : dataTypes) {
-                for (int size : sizes) {
-                    for (int distribution : distributions) {
-                        Arguments testCase = {
-                                .mode = Mode::BENCHMARK,
-                                .algorithm = algorithm,
-                                .dataType = dataType,
-                                .inputFile = "",
-                                .outputFile = args.outputFile,
-                                .size = size,
-                                .distribution = distribution,
-                                .drunkLevel = 0
-                        };
-                        try {
-                            benchmark(testCase);
-                        } catch (const std::exception& e) {
-                            std::cerr << "Error during test: " << e.what() << std::endl;
+        const std::vector<int> allTypes = {0, 1, 2}; // int, float, char
+        const std::vector<size_t> defaultSizes = {10000, 20000, 30000, 40000, 50000};
+        const std::vector<int> allDistributions = {0, 1, 2, 3, 4}; // Random, Descending, Ascending, 33%, 66%
+
+        // Test cases run by each test suite option
+        const std::unordered_map<int, TestSuite> suites = {
+                //{0, {{0, 1, 2, 3, 4, 5}, allTypes, defaultSizes, allDistributions}}, // Bubble, Merge, Insert, Binary Insert, Quick, Heap
+                {0, {{2}, allTypes, defaultSizes, allDistributions}}, // Reduced for testing
+                {1, {{4, 7}, allTypes, defaultSizes, allDistributions}}, // Quick vs Intro: last-element pivot against median-of-three on sorted inputs
+                {2, {{4, 5, 7}, {0}, {1ULL << 20, 1ULL << 24, 1ULL << 28, (1ULL << 31) + 1, 5ULL << 30}, {0}, 3}}, // Size sweep past 2^32 elements
+                {3, {{4, 8}, {0, 1}, {1000000, 4000000, 16000000}, {0}, 10, 4}}, // Parallel Quick speedup over serial Quick
+                {4, {{1, 9}, {0, 1}, {1000000, 4000000, 16000000}, {0}, 10, 1}}, // Parallel Merge speedup over serial Merge
+                {5, {{1, 5, 12, 13}, allTypes, {1000000, 4000000, 16000000}, {0, 3}, 5}}, // Radix sorts against Merge and Heap: time and scratch memory
+                {6, {{7, 18}, allTypes, {1000000, 4000000, 16000000}, {0, 3}, 5, 7}}, // Block Quick against Intro: speedup and branch misses
+                {7, {{1, 19}, {0, 1}, {1000000, 4000000}, allDistributions, 5, 1}}, // Powersort against Merge on presorted inputs
+                {8, {{5, 20, 21}, {0}, {1ULL << 16, 1ULL << 20, 1ULL << 24, 1ULL << 26}, {0}, 3, 5}}, // d-ary Heap against binary Heap, from L2-sized to far past the LLC
+                {9, {{6}, {0, 1}, {10000, 100000, 1000000}, {0, 3}, 10, -1, {"shell", "knuth", "sedgewick", "pratt", "ciura", "tokuda"}}}, // Shell Sort gap sequences
+                {10, {{7, 22}, {0, 2}, {100000, 1000000, 10000000}, {0, 5}, 10, 7}}, // 3-Way Quick against Intro on char and few-unique data
+                {11, {{7, 23}, {0, 1, 2}, {1000000, 4000000}, {0, 3}, 10, 7}}, // Dual-Pivot Quick against Intro, tuned with --pivots and --cutoff
+                {12, {{8, 24}, {0, 1}, {1000000, 4000000, 16000000}, {0, 3}, 5, 8}} // Parallel Sample against Parallel Quick, see --threads and --bucket-sort
+        };
+
+        auto found = suites.find(args.testOption);
+        if (found == suites.end()) {
+            throw std::invalid_argument("Invalid test option");
+        }
+        const TestSuite& suite = found->second;
+        std::map<std::tuple<int, size_t, int>, double> baselineTimes; // (type, size, distribution) -> avg ms
+        const std::vector<std::string> gapSequences = suite.gapSequences.empty()
+                ? std::vector<std::string>{args.gapSequence} : suite.gapSequences;
+
+        for (int algorithm : suite.algorithms) {
+            for (int dataType : suite.dataTypes) {
+                for (size_t size : suite.sizes) {
+                    for (int distribution : suite.distributions) {
+                        for (const std::string& gapSequence : gapSequences) {
+                            Arguments testCase = {
+                                    .mode = Mode::BENCHMARK,
+                                    .algorithm = algorithm,
+                                    .dataType = dataType,
+                                    .inputFile = "",
+                                    .outputFile = args.outputFile,
+                                    .size = size,
+                                    .distribution = distribution,
+                                    .drunkLevel = 0,
+                                    .iterations = suite.iterations > 0 ? suite.iterations : args.iterations,
+                                    .testOption = args.testOption,
+                                    .allocator = args.allocator,
+                                    .threads = args.threads,
+                                    .gapSequence = gapSequence,
+                                    .lowPivotRank = args.lowPivotRank,
+                                    .highPivotRank = args.highPivotRank,
+                                    .insertionCutoff = args.insertionCutoff,
+                                    .selection = "",
+                                    .rank = 0,
+                                    .memoryBudget = args.memoryBudget,
+                                    .tempDirectory = args.tempDirectory,
+                                    .bucketAlgorithm = args.bucketAlgorithm,
+                                    .sampleSeed = args.sampleSeed
+                            };
+                            try {
+                                double avgTime = benchmark(testCase);
+                                auto key = std::make_tuple(dataType, size, distribution);
+                                if (algorithm == suite.baseline) {
+                                    baselineTimes[key] = avgTime;
+                                } else if (baselineTimes.count(key) > 0 && avgTime > 0) {
+                                    std::cout << "Speedup of " << algToString(algorithm) << " over " << algToString(suite.baseline)
+                                              << " (" << typeToString(dataType) << ", " << distToString(distribution) << ", " << size
+                                              << ", " << threadsUsed(testCase) << " threads): "
+                                              << baselineTimes[key] / avgTime << "x" << std::endl;
+                                }
+                            } catch (const std::exception& e) {
+                                std::cerr << "Error during test: " << e.what() << std::endl;
+                            }
                         }
                     }
                 }
@@ -389,7 +706,8 @@ private:
     }
 
     // Excel data writer
-    static void writeDataToExcel(const std::string &filename, DynamicArray<int>* times, const Arguments &args) {
+    static void writeDataToExcel(const std::string &filename, DynamicArray<long long>* times, const Arguments &args,
+                                 size_t peakMemory = 0, long long branchMisses = -1) {
         bool fileExists = std::filesystem::exists(filename);
         bool isEmpty = fileExists && std::filesystem::file_size(filename) == 0;
 
@@ -400,32 +718,37 @@ private:
 
         if (!fileExists || isEmpty) {
             // Write column names if the file doesn't exist or is empty
-            outputFile << "RecordNumber,MinTime,MaxTime,AvgTime,MedianTime,StdDev,Algorithm,Distribution,Size,DataType,DrunkLevel" << std::endl;
+            outputFile << "RecordNumber,MinTime,MaxTime,AvgTime,MedianTime,StdDev,Algorithm,Distribution,Size,DataType,DrunkLevel,Allocator,Threads,PeakMemory,Throughput,BranchMisses,GapSequence,PivotRanks,InsertionCutoff,BucketSort" << std::endl;
         }
 
         static int recordNumber = 1; // Static variable to keep track of record numbers
-        Sorter<int>::quickSort(times, 0, times->getSize() - 1);
-        int minTime = times->get(0);
-        int maxTime = times->get(times->getSize() - 1);
-        int medianTime = times->get(49);
+        size_t count = times->getSize();
+        auto [minIt, maxIt] = std::minmax_element(times->begin(), times->end());
+        long long minTime = *minIt;
+        long long maxTime = *maxIt;
+        Sorter<long long>::nthElement(times, (count - 1) / 2); // Only the median needs order
+        long long medianTime = times->get((count - 1) / 2);
         auto algorithm = algToString(args.algorithm);
         auto distribution = distToString(args.distribution);
         auto dataType = typeToString(args.dataType);
         float avgTime = 0;
 
-        for(int i = 0; i < 100; i++) {
+        for(size_t i = 0; i < count; i++) {
             avgTime += times->get(i);
         }
 
-        avgTime /= 100;
+        avgTime /= count;
 
         // calculate standard deviation
         float stdDev = 0;
-        for(int i = 0; i < 100; i++) {
+        for(size_t i = 0; i < count; i++) {
             stdDev += (times->get(i) - avgTime) * (times->get(i) - avgTime);
         }
 
-        stdDev  = std::sqrt(stdDev / 100);
+        stdDev  = std::sqrt(stdDev / count);
+
+        // Million elements sorted per second at the average time
+        double throughput = avgTime > 0 ? args.size / (avgTime * 1000.0) : 0;
         outputFile << recordNumber++ << ","
                     << minTime << ","
                     << maxTime << ","
@@ -436,7 +759,16 @@ private:
                     << distribution << ","
                     << args.size << ","
                     << dataType << ","
-                    << args.drunkLevel
+                    << args.drunkLevel << ","
+                    << args.allocator << ","
+                    << threadsUsed(args) << ","
+                    << peakMemory << ","
+                    << throughput << ","
+                    << branchMisses << ","
+                    << (args.algorithm == 6 ? args.gapSequence : "-") << ","
+                    << (args.algorithm == 23 ? std::to_string(args.lowPivotRank) + "/" + std::to_string(args.highPivotRank) : "-") << ","
+                    << (args.algorithm == 23 ? std::to_string(args.insertionCutoff) : "-") << ","
+                    << (args.algorithm == 24 ? algToString(args.bucketAlgorithm) : "-")
                     << std::endl;
 
 
@@ -453,6 +785,24 @@ private:
                 {4, "Quick Sort"},
                 {5, "Heap Sort"},
                 {6, "Shell Sort"},
+                {7, "Intro Sort"},
+                {8, "Parallel Quick Sort"},
+                {9, "Parallel Merge Sort"},
+                {10, "Ping-pong Merge Sort"},
+                {11, "Bottom-up Merge Sort"},
+                {12, "LSD Radix Sort"},
+                {13, "American Flag Sort"},
+                {14, "Counting Sort"},
+                {15, "Auto Sort"},
+                {16, "SIMD Merge Sort"},
+                {17, "Vector Quick Sort"},
+                {18, "Block Quick Sort"},
+                {19, "Powersort"},
+                {20, "4-ary Heap Sort"},
+                {21, "8-ary Heap Sort"},
+                {22, "3-Way Quick Sort"},
+                {23, "Dual-Pivot Quick Sort"},
+                {24, "Parallel Sample Sort"},
         };
 
         auto it = algorithmNames.find(algorithm);
@@ -466,6 +816,7 @@ private:
                 {2, "Ascending"},
                 {3, "33% Sorted"},
                 {4, "66% Sorted"},
+                {5, "Few Unique"},
         };
 
         auto it = distributionNames.find(distribution);
@@ -0,0 +1 @@
+#include "MemoryResource.h"
@@ -0,0 +1,409 @@
+#ifndef AIZOPROJEKT_MEMORYRESOURCE_H
+#define AIZOPROJEKT_MEMORYRESOURCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Expected access pattern of an algorithm phase, forwarded to madvise where possible
+enum class AccessPattern {
+    Normal,
+    Sequential,
+    Random
+};
+
+// Source of raw storage for DynamicArray. Resources are selected at run time
+// (see byName) so the benchmark driver can compare them without recompiling.
+class MemoryResource {
+public:
+    static constexpr size_t cacheLine = 64;
+    static constexpr size_t hugePage = 2 * 1024 * 1024;
+
+    virtual ~MemoryResource() = default;
+
+    // Allocate bytes of uninitialized storage, throwing std::bad_alloc on failure
+    virtual void* allocate(size_t bytes) = 0;
+
+    // Release storage obtained from allocate/reallocate with the same size
+    virtual void deallocate(void* memory, size_t bytes) = 0;
+
+    // Resize a block of trivially copyable data, keeping min(oldBytes, newBytes) bytes
+    virtual void* reallocate(void* memory, size_t oldBytes, size_t newBytes) {
+        void* newMemory = allocate(newBytes);
+        if (memory != nullptr) {
+            std::memcpy(newMemory, memory, std::min(oldBytes, newBytes));
+            deallocate(memory, oldBytes);
+        }
+        return newMemory;
+    }
+
+    // Hint how a block is about to be accessed (no-op unless the storage is mapped)
+    virtual void advise(void*, size_t, AccessPattern) {}
+
+    // Name used on the command line and in benchmark results
+    virtual const char* name() const = 0;
+
+    // Default resource (plain malloc/realloc)
+    static MemoryResource* heap();
+
+    // Resource registered under the given name ("heap", "aligned", "thp", "hugetlb", "arena")
+    static MemoryResource* byName(const std::string& name);
+
+protected:
+    static size_t roundUp(size_t bytes, size_t alignment) {
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    static void adviseMapping(void* memory, size_t bytes, AccessPattern pattern) {
+        static const int advice[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM};
+        if (memory != nullptr && bytes > 0) {
+            madvise(memory, bytes, advice[static_cast<int>(pattern)]);
+        }
+    }
+#endif
+};
+
+// malloc/realloc/free, the original behaviour of DynamicArray
+class HeapResource : public MemoryResource {
+public:
+    void* allocate(size_t bytes) override {
+        void* memory = std::malloc(bytes);
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void deallocate(void* memory, size_t) override {
+        std::free(memory);
+    }
+
+    void* reallocate(void* memory, size_t, size_t newBytes) override {
+        void* newMemory = std::realloc(memory, newBytes);
+        if (newMemory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return newMemory;
+    }
+
+    const char* name() const override {
+        return "heap";
+    }
+};
+
+// Cache-line (64 byte) aligned blocks, so SIMD kernels never split a load
+class AlignedResource : public MemoryResource {
+public:
+    void* allocate(size_t bytes) override {
+        size_t size = roundUp(std::max<size_t>(bytes, 1), cacheLine);
+#ifdef _MSC_VER
+        void* memory = _aligned_malloc(size, cacheLine);
+#else
+        void* memory = std::aligned_alloc(cacheLine, size);
+#endif
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void deallocate(void* memory, size_t) override {
+#ifdef _MSC_VER
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+
+    const char* name() const override {
+        return "aligned";
+    }
+};
+
+// Anonymous mappings rounded to 2 MB. With explicitPages the mapping asks for
+// MAP_HUGETLB (falling back to a normal mapping when the hugetlb pool is
+// empty), otherwise transparent huge pages are requested with madvise.
+// On systems without mmap it degrades to AlignedResource.
+class HugePageResource : public AlignedResource {
+public:
+    explicit HugePageResource(bool explicitPages) : explicitPages(explicitPages) {}
+
+#ifdef __linux__
+    void* allocate(size_t bytes) override {
+        size_t size = roundUp(std::max<size_t>(bytes, 1), hugePage);
+        void* memory = MAP_FAILED;
+        if (explicitPages) {
+            memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+        if (memory == MAP_FAILED) {
+            memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            madvise(memory, size, MADV_HUGEPAGE);
+        }
+        return memory;
+    }
+
+    void deallocate(void* memory, size_t bytes) override {
+        if (memory != nullptr) {
+            munmap(memory, roundUp(std::max<size_t>(bytes, 1), hugePage));
+        }
+    }
+
+    void* reallocate(void* memory, size_t oldBytes, size_t newBytes) override {
+        if (memory == nullptr) {
+            return allocate(newBytes);
+        }
+        size_t oldSize = roundUp(std::max<size_t>(oldBytes, 1), hugePage);
+        size_t newSize = roundUp(std::max<size_t>(newBytes, 1), hugePage);
+        if (oldSize == newSize) {
+            return memory;
+        }
+        if (!explicitPages) {
+            // Let the kernel move the page tables instead of copying the data
+            void* newMemory = mremap(memory, oldSize, newSize, MREMAP_MAYMOVE);
+            if (newMemory != MAP_FAILED) {
+                if (newSize > oldSize) {
+                    madvise(newMemory, newSize, MADV_HUGEPAGE);
+                }
+                return newMemory;
+            }
+        }
+        return MemoryResource::reallocate(memory, oldBytes, newBytes);
+    }
+
+    void advise(void* memory, size_t bytes, AccessPattern pattern) override {
+        adviseMapping(memory, roundUp(bytes, hugePage), pattern);
+    }
+#endif
+
+    const char* name() const override {
+        return explicitPages ? "hugetlb" : "thp";
+    }
+
+private:
+    bool explicitPages;
+};
+
+// Bump-pointer arena. Blocks are carved from large chunks and only reclaimed
+// when every block has been released (or the latest block is released first);
+// the chunks are then merged into one and reused, so repeated benchmark
+// iterations never go back to the system allocator. Not thread safe.
+class ArenaResource : public MemoryResource {
+public:
+    explicit ArenaResource(size_t chunkSize = 64 * 1024 * 1024) : chunkSize(chunkSize) {}
+
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+
+    ~ArenaResource() override {
+        for (auto& chunk : chunks) {
+            chunkSource.deallocate(chunk.first, chunk.second);
+        }
+    }
+
+    void* allocate(size_t bytes) override {
+        size_t size = roundUp(std::max<size_t>(bytes, 1), cacheLine);
+        if (chunks.empty() || offset + size > chunks[current].second) {
+            nextChunk(size);
+        }
+        char* memory = static_cast<char*>(chunks[current].first) + offset;
+        lastBlock = memory;
+        offset += size;
+        live++;
+        return memory;
+    }
+
+    void deallocate(void* memory, size_t bytes) override {
+        if (memory == nullptr) {
+            return;
+        }
+        if (memory == lastBlock) {
+            offset -= roundUp(std::max<size_t>(bytes, 1), cacheLine);
+            lastBlock = nullptr;
+        }
+        if (--live == 0) {
+            reset();
+        }
+    }
+
+    void* reallocate(void* memory, size_t oldBytes, size_t newBytes) override {
+        // The most recent block can grow or shrink in place
+        if (memory != nullptr && memory == lastBlock) {
+            size_t start = static_cast<char*>(memory) - static_cast<char*>(chunks[current].first);
+            size_t size = roundUp(std::max<size_t>(newBytes, 1), cacheLine);
+            if (start + size <= chunks[current].second) {
+                offset = start + size;
+                return memory;
+            }
+        }
+        return MemoryResource::reallocate(memory, oldBytes, newBytes);
+    }
+
+    const char* name() const override {
+        return "arena";
+    }
+
+private:
+    AlignedResource chunkSource;
+    std::vector<std::pair<void*, size_t>> chunks;   // (memory, bytes)
+    size_t chunkSize;
+    size_t current = 0;     // Chunk currently being carved
+    size_t offset = 0;      // First free byte in the current chunk
+    size_t live = 0;        // Blocks handed out and not yet released
+    void* lastBlock = nullptr;
+
+    void nextChunk(size_t required) {
+        if (!chunks.empty() && current + 1 < chunks.size() && chunks[current + 1].second >= required) {
+            current++;
+        } else {
+            size_t size = std::max(chunkSize, required);
+            chunks.emplace_back(chunkSource.allocate(size), size);
+            current = chunks.size() - 1;
+        }
+        offset = 0;
+    }
+
+    // Called when nothing is live: keep a single chunk big enough for the whole peak
+    void reset() {
+        if (chunks.size() > 1) {
+            size_t total = 0;
+            for (auto& chunk : chunks) {
+                total += chunk.second;
+                chunkSource.deallocate(chunk.first, chunk.second);
+            }
+            chunks.clear();
+            chunks.emplace_back(chunkSource.allocate(total), total);
+        }
+        current = 0;
+        offset = 0;
+        lastBlock = nullptr;
+    }
+};
+
+// Shared mapping of a binary file. allocate(bytes) maps the first bytes of the
+// file (extending it if needed), so the storage already holds the file
+// contents: a DynamicArray adopts them with uninitializedTail()/commit(), and
+// everything written to the array lands in the file without serialization.
+// One mapping at a time; growing remaps the (extended) file.
+class MappedFileResource : public MemoryResource {
+public:
+    // Open (or create) the file; truncate discards its current contents
+    explicit MappedFileResource(const std::string& path, bool truncate = false) : path(path) {
+#if defined(__unix__) || defined(__APPLE__)
+        descriptor = open(path.c_str(), O_RDWR | O_CREAT | (truncate ? O_TRUNC : 0), 0644);
+        if (descriptor < 0) {
+            throw std::runtime_error("Unable to open mapped file: " + path);
+        }
+#else
+        throw std::runtime_error("Memory-mapped files are not supported on this platform");
+#endif
+    }
+
+    MappedFileResource(const MappedFileResource&) = delete;
+    MappedFileResource& operator=(const MappedFileResource&) = delete;
+
+#if defined(__unix__) || defined(__APPLE__)
+    ~MappedFileResource() override {
+        close(descriptor);
+    }
+
+    // Current length of the file in bytes
+    size_t length() const {
+        struct stat info {};
+        if (fstat(descriptor, &info) != 0) {
+            throw std::runtime_error("Unable to stat mapped file: " + path);
+        }
+        return static_cast<size_t>(info.st_size);
+    }
+
+    void* allocate(size_t bytes) override {
+        if (mapping != nullptr) {
+            throw std::logic_error("Mapped file is already in use: " + path);
+        }
+        if (length() < bytes && ftruncate(descriptor, static_cast<off_t>(bytes)) != 0) {
+            throw std::runtime_error("Unable to extend mapped file: " + path);
+        }
+        void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        if (memory == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        mapping = memory;
+        return memory;
+    }
+
+    void deallocate(void* memory, size_t bytes) override {
+        if (memory != nullptr) {
+            munmap(memory, bytes);
+            mapping = nullptr;
+        }
+    }
+
+    // The data lives in the file, so remapping it is enough to resize
+    void* reallocate(void* memory, size_t oldBytes, size_t newBytes) override {
+        deallocate(memory, oldBytes);
+        return allocate(newBytes);
+    }
+
+    void advise(void* memory, size_t bytes, AccessPattern pattern) override {
+        adviseMapping(memory, bytes, pattern);
+    }
+#else
+    size_t length() const { return 0; }
+    void* allocate(size_t) override { throw std::bad_alloc(); }
+    void deallocate(void*, size_t) override {}
+#endif
+
+    const char* name() const override {
+        return "mmap";
+    }
+
+private:
+    std::string path;
+    int descriptor = -1;
+    void* mapping = nullptr;
+};
+
+inline MemoryResource* MemoryResource::heap() {
+    static HeapResource resource;
+    return &resource;
+}
+
+inline MemoryResource* MemoryResource::byName(const std::string& name) {
+    static AlignedResource aligned;
+    static HugePageResource transparentHugePages(false);
+    static HugePageResource explicitHugePages(true);
+    static ArenaResource arena;
+    static const std::unordered_map<std::string, MemoryResource*> resources = {
+            {"heap", heap()},
+            {"aligned", &aligned},
+            {"thp", &transparentHugePages},
+            {"hugetlb", &explicitHugePages},
+            {"arena", &arena}
+    };
+
+    auto resource = resources.find(name);
+    if (resource == resources.end()) {
+        throw std::invalid_argument("Unknown allocator: " + name);
+    }
+    return resource->second;
+}
+
+#endif // AIZOPROJEKT_MEMORYRESOURCE_H
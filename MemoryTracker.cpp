@@ -0,0 +1,34 @@
+#include "MemoryTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+// Global operator new/delete replacements feeding MemoryTracker. Every block
+// carries its size in a header that keeps the default new alignment; the
+// array, nothrow and sized forms of the standard library forward here.
+namespace {
+    constexpr size_t headerSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+void* operator new(size_t bytes) {
+    void* block = std::malloc(bytes + headerSize);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(block) = bytes;
+    MemoryTracker::allocated(bytes);
+    return static_cast<char*>(block) + headerSize;
+}
+
+void operator delete(void* memory) noexcept {
+    if (memory == nullptr) {
+        return;
+    }
+    void* block = static_cast<char*>(memory) - headerSize;
+    MemoryTracker::released(*static_cast<size_t*>(block));
+    std::free(block);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    operator delete(memory);
+}
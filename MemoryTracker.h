@@ -0,0 +1,44 @@
+#ifndef AIZOPROJEKT_MEMORYTRACKER_H
+#define AIZOPROJEKT_MEMORYTRACKER_H
+
+#include <atomic>
+#include <cstddef>
+
+// Bytes held through operator new, counted by the replacement operators in
+// MemoryTracker.cpp. Sorting algorithms take their scratch memory from new,
+// while DynamicArray storage comes from a MemoryResource, so the peak between
+// reset() and peak() is the extra memory an algorithm needed on top of its input.
+class MemoryTracker {
+public:
+    // Start a new measurement from the current amount of live memory
+    static void reset() {
+        size_t live = current.load(std::memory_order_relaxed);
+        baseline.store(live, std::memory_order_relaxed);
+        highest.store(live, std::memory_order_relaxed);
+    }
+
+    // Highest number of bytes allocated on top of the baseline since reset()
+    static size_t peak() {
+        size_t top = highest.load(std::memory_order_relaxed);
+        size_t base = baseline.load(std::memory_order_relaxed);
+        return top > base ? top - base : 0;
+    }
+
+    static void allocated(size_t bytes) {
+        size_t live = current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t top = highest.load(std::memory_order_relaxed);
+        while (live > top && !highest.compare_exchange_weak(top, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void released(size_t bytes) {
+        current.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+private:
+    static inline std::atomic<size_t> current{0};
+    static inline std::atomic<size_t> highest{0};
+    static inline std::atomic<size_t> baseline{0};
+};
+
+#endif // AIZOPROJEKT_MEMORYTRACKER_H
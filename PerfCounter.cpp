@@ -0,0 +1 @@
+#include "PerfCounter.h"
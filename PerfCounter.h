@@ -0,0 +1,82 @@
+#ifndef AIZOPROJEKT_PERFCOUNTER_H
+#define AIZOPROJEKT_PERFCOUNTER_H
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware event counter for the calling thread, read through perf_event_open
+// on Linux. Where the kernel, the hypervisor or the platform does not expose
+// the event, available() is false and result() stays -1.
+class PerfCounter {
+public:
+    enum class Event {
+        BranchMisses,
+        Branches
+    };
+
+    explicit PerfCounter(Event event) {
+#if defined(__linux__)
+        perf_event_attr attributes{};
+        attributes.size = sizeof(attributes);
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = event == Event::BranchMisses ? PERF_COUNT_HW_BRANCH_MISSES : PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#else
+        (void) event;
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    ~PerfCounter() {
+#if defined(__linux__)
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    bool available() const {
+        return fd >= 0;
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#if defined(__linux__)
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            std::uint64_t value = 0;
+            count = read(fd, &value, sizeof(value)) == sizeof(value) ? static_cast<long long>(value) : -1;
+        }
+#endif
+    }
+
+    // Events counted between the last start() and stop(), -1 when unavailable
+    long long result() const {
+        return count;
+    }
+
+private:
+    int fd = -1;
+    long long count = -1;
+};
+
+#endif // AIZOPROJEKT_PERFCOUNTER_H
@@ -0,0 +1 @@
+#include "RadixKey.h"
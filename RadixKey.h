@@ -0,0 +1,44 @@
+#ifndef AIZOPROJEKT_RADIXKEY_H
+#define AIZOPROJEKT_RADIXKEY_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Order-preserving mapping of a value to an unsigned key, used by the radix
+// sorts: comparing keys as unsigned integers gives the same order as
+// comparing the original values with operator<.
+template <typename T, typename = void>
+struct RadixKey {
+    static constexpr bool supported = false;
+};
+
+// Integers: flip the sign bit so negative values sort before positive ones
+template <typename T>
+struct RadixKey<T, std::enable_if_t<std::is_integral_v<T>>> {
+    static constexpr bool supported = true;
+    using Key = std::make_unsigned_t<T>;
+    static constexpr Key signBit = std::is_signed_v<T> ? Key(Key(1) << (sizeof(Key) * 8 - 1)) : Key(0);
+
+    static Key toKey(T value) {
+        return static_cast<Key>(static_cast<Key>(value) ^ signBit);
+    }
+};
+
+// IEEE floats: set the sign bit of positive values and invert every bit of
+// negative ones, so -0.0 lands just below +0.0 and larger magnitudes of
+// negative numbers sort first
+template <typename T>
+struct RadixKey<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static constexpr bool supported = sizeof(T) == 4 || sizeof(T) == 8;
+    using Key = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    static constexpr Key signBit = Key(Key(1) << (sizeof(Key) * 8 - 1));
+
+    static Key toKey(T value) {
+        Key bits;
+        std::memcpy(&bits, &value, sizeof(Key));
+        return (bits & signBit) ? Key(~bits) : Key(bits | signBit);
+    }
+};
+
+#endif // AIZOPROJEKT_RADIXKEY_H
@@ -0,0 +1 @@
+#include "SimdSort.h"
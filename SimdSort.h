@@ -0,0 +1,408 @@
+#ifndef AIZOPROJEKT_SIMDSORT_H
+#define AIZOPROJEKT_SIMDSORT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// AVX2 kernels are compiled on x86 with GCC/Clang through a target attribute
+// and picked at run time, so the binary still runs on CPUs without AVX2.
+// MSVC needs /arch:AVX2 (which defines __AVX2__) to get them at all.
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(__GNUC__)
+#define SIMD_SORT_AVX2 1
+#define SIMD_SORT_TARGET __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define SIMD_SORT_AVX2 1
+#define SIMD_SORT_TARGET
+#endif
+#endif
+
+#ifdef SIMD_SORT_AVX2
+
+// 8-lane AVX2 operations on 32-bit elements; shuffles work on the integer view
+template <typename T>
+struct Avx2Ops;
+
+template <>
+struct Avx2Ops<int> {
+    using Vec = __m256i;
+    SIMD_SORT_TARGET static Vec load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    SIMD_SORT_TARGET static void store(int* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    SIMD_SORT_TARGET static Vec min(Vec a, Vec b) { return _mm256_min_epi32(a, b); }
+    SIMD_SORT_TARGET static Vec max(Vec a, Vec b) { return _mm256_max_epi32(a, b); }
+    SIMD_SORT_TARGET static Vec set1(int value) { return _mm256_set1_epi32(value); }
+    SIMD_SORT_TARGET static int lessMask(Vec v, Vec pivot) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v)));
+    }
+    SIMD_SORT_TARGET static int lessEqualMask(Vec v, Vec pivot) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, pivot))) ^ 0xFF;
+    }
+    SIMD_SORT_TARGET static __m256i toBits(Vec v) { return v; }
+    SIMD_SORT_TARGET static Vec fromBits(__m256i v) { return v; }
+};
+
+template <>
+struct Avx2Ops<float> {
+    using Vec = __m256;
+    SIMD_SORT_TARGET static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+    SIMD_SORT_TARGET static void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+    SIMD_SORT_TARGET static Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+    SIMD_SORT_TARGET static Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+    SIMD_SORT_TARGET static Vec set1(float value) { return _mm256_set1_ps(value); }
+    SIMD_SORT_TARGET static int lessMask(Vec v, Vec pivot) { return _mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_LT_OQ)); }
+    SIMD_SORT_TARGET static int lessEqualMask(Vec v, Vec pivot) { return _mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_LE_OQ)); }
+    SIMD_SORT_TARGET static __m256i toBits(Vec v) { return _mm256_castps_si256(v); }
+    SIMD_SORT_TARGET static Vec fromBits(__m256i v) { return _mm256_castsi256_ps(v); }
+};
+
+// Sorting network and bitonic merge kernels on 8-element vectors
+template <typename T>
+struct Avx2Kernels {
+    using Ops = Avx2Ops<T>;
+    using Vec = typename Ops::Vec;
+
+    SIMD_SORT_TARGET static void compareExchange(Vec& a, Vec& b) {
+        Vec low = Ops::min(a, b);
+        b = Ops::max(a, b);
+        a = low;
+    }
+
+    SIMD_SORT_TARGET static Vec permute(Vec v, __m256i index) {
+        return Ops::fromBits(_mm256_permutevar8x32_epi32(Ops::toBits(v), index));
+    }
+
+    // Lanes whose bit is set in Mask come from b, the others from a
+    template <int Mask>
+    SIMD_SORT_TARGET static Vec blend(Vec a, Vec b) {
+        return Ops::fromBits(_mm256_blend_epi32(Ops::toBits(a), Ops::toBits(b), Mask));
+    }
+
+    // One half-cleaner step: each lane is compared with its partner lane and
+    // the lanes set in Mask keep the larger value
+    template <int Mask>
+    SIMD_SORT_TARGET static Vec cleanStep(Vec v, __m256i partner) {
+        Vec swapped = permute(v, partner);
+        return blend<Mask>(Ops::min(v, swapped), Ops::max(v, swapped));
+    }
+
+    // Sort a bitonic vector with half-cleaners at lane distances 4, 2 and 1
+    SIMD_SORT_TARGET static Vec bitonicClean(Vec v) {
+        v = cleanStep<0xF0>(v, _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3));
+        v = cleanStep<0xCC>(v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5));
+        return cleanStep<0xAA>(v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6));
+    }
+
+    // Merge the sorted runs v[0, Count/2) and v[Count/2, Count): reversing the
+    // second run makes the whole sequence bitonic, then half-cleaners sort it
+    template <size_t Count>
+    SIMD_SORT_TARGET static void bitonicMerge(Vec* v) {
+        constexpr size_t half = Count / 2;
+        const __m256i reversed = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        for (size_t i = 0; i < half / 2; i++) {
+            std::swap(v[half + i], v[Count - 1 - i]);
+        }
+        for (size_t i = half; i < Count; i++) {
+            v[i] = permute(v[i], reversed);
+        }
+        for (size_t distance = half; distance > 0; distance /= 2) {
+            for (size_t i = 0; i < Count; i++) {
+                if ((i & distance) == 0) {
+                    compareExchange(v[i], v[i + distance]);
+                }
+            }
+        }
+        for (size_t i = 0; i < Count; i++) {
+            v[i] = bitonicClean(v[i]);
+        }
+    }
+
+    // Transpose the 8x8 matrix held in v[0..7]
+    SIMD_SORT_TARGET static void transpose(Vec* v) {
+        __m256i t[8];
+        for (size_t i = 0; i < 8; i += 2) {
+            t[i] = _mm256_unpacklo_epi32(Ops::toBits(v[i]), Ops::toBits(v[i + 1]));
+            t[i + 1] = _mm256_unpackhi_epi32(Ops::toBits(v[i]), Ops::toBits(v[i + 1]));
+        }
+        __m256i s[8];
+        for (size_t i = 0; i < 8; i += 4) {
+            s[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+            s[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+            s[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+            s[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+        for (size_t i = 0; i < 4; i++) {
+            v[i] = Ops::fromBits(_mm256_permute2x128_si256(s[i], s[i + 4], 0x20));
+            v[i + 4] = Ops::fromBits(_mm256_permute2x128_si256(s[i], s[i + 4], 0x31));
+        }
+    }
+
+    // Sort 64 elements: an optimal 19-comparator network sorts the columns of
+    // the 8x8 matrix, the transpose turns them into sorted rows, and three
+    // levels of bitonic merges join the rows
+    SIMD_SORT_TARGET static void sort64(T* a) {
+        static constexpr size_t network[19][2] = {
+                {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3},
+                {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}
+        };
+        Vec v[8];
+        for (size_t i = 0; i < 8; i++) {
+            v[i] = Ops::load(a + 8 * i);
+        }
+        for (const auto& comparator : network) {
+            compareExchange(v[comparator[0]], v[comparator[1]]);
+        }
+        transpose(v);
+        for (size_t i = 0; i < 8; i += 2) {
+            bitonicMerge<2>(v + i);
+        }
+        bitonicMerge<4>(v);
+        bitonicMerge<4>(v + 4);
+        bitonicMerge<8>(v);
+        for (size_t i = 0; i < 8; i++) {
+            Ops::store(a + 8 * i, v[i]);
+        }
+    }
+
+    // Blocks shorter than 64 are padded with the largest value
+    SIMD_SORT_TARGET static void sortBlock(T* a, size_t n) {
+        if (n == 64) {
+            sort64(a);
+            return;
+        }
+        T block[64];
+        std::copy(a, a + n, block);
+        std::fill(block + n, block + 64, std::numeric_limits<T>::has_infinity
+                                         ? std::numeric_limits<T>::infinity()
+                                         : std::numeric_limits<T>::max());
+        sort64(block);
+        std::copy(block, block + n, a);
+    }
+
+    // Merge two sorted runs 8 elements at a time: the upper half of every
+    // bitonic merge is held back and merged with the next vector taken from
+    // whichever run has the smaller head
+    SIMD_SORT_TARGET static void mergeRuns(const T* left, size_t leftSize, const T* right, size_t rightSize,
+                                           T* output, void (*scalarMerge)(const T*, size_t, const T*, size_t, T*)) {
+        T spare[2][16];
+        size_t current = 0;
+        while (leftSize >= 8 && rightSize >= 8) {
+            Vec v[2] = {Ops::load(left), Ops::load(right)};
+            size_t i = 8;
+            size_t j = 8;
+            bool fromLeft;
+            while (true) {
+                bitonicMerge<2>(v);
+                Ops::store(output, v[0]);
+                output += 8;
+                v[0] = v[1];
+                fromLeft = j >= rightSize || (i < leftSize && left[i] <= right[j]);
+                if (fromLeft && i + 8 <= leftSize) {
+                    v[1] = Ops::load(left + i);
+                    i += 8;
+                } else if (!fromLeft && j + 8 <= rightSize) {
+                    v[1] = Ops::load(right + j);
+                    j += 8;
+                } else {
+                    break;
+                }
+            }
+
+            // The run that goes next has fewer than 8 elements left: merge them
+            // with the held vector into a short run that takes its place
+            T held[8];
+            Ops::store(held, v[0]);
+            current ^= 1;
+            if (fromLeft) {
+                scalarMerge(held, 8, left + i, leftSize - i, spare[current]);
+                leftSize = 8 + leftSize - i;
+                left = spare[current];
+                right += j;
+                rightSize -= j;
+            } else {
+                scalarMerge(held, 8, right + j, rightSize - j, spare[current]);
+                rightSize = 8 + rightSize - j;
+                right = spare[current];
+                left += i;
+                leftSize -= i;
+            }
+        }
+        scalarMerge(left, leftSize, right, rightSize, output);
+    }
+
+    // For every 8-bit lane mask, the lanes set in the mask followed by the
+    // others, packed as 4-bit permutation indices
+    static constexpr std::array<std::uint32_t, 256> makeCompressTable() {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t mask = 0; mask < 256; mask++) {
+            std::uint32_t entry = 0;
+            std::uint32_t slot = 0;
+            for (std::uint32_t lane = 0; lane < 8; lane++) {
+                if (mask & (1u << lane)) entry |= lane << (4 * slot++);
+            }
+            for (std::uint32_t lane = 0; lane < 8; lane++) {
+                if (!(mask & (1u << lane))) entry |= lane << (4 * slot++);
+            }
+            table[mask] = entry;
+        }
+        return table;
+    }
+
+    static constexpr std::array<std::uint32_t, 256> compressTable = makeCompressTable();
+
+    // Split one vector around the pivot: a single permutation packs the lower
+    // lanes to the front, and the packed vector is stored at both write heads,
+    // so leftOut receives the lower lanes and the rest ends at rightEnd
+    SIMD_SORT_TARGET static size_t partitionVector(Vec v, Vec pivot, bool orEqual, T* leftOut, T* rightEnd) {
+        int mask = orEqual ? Ops::lessEqualMask(v, pivot) : Ops::lessMask(v, pivot);
+        __m256i index = _mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(compressTable[mask])),
+                                          _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+        Vec packed = permute(v, _mm256_and_si256(index, _mm256_set1_epi32(0xF)));
+        Ops::store(leftOut, packed);
+        Ops::store(rightEnd - 8, packed);
+        return static_cast<size_t>(_mm_popcnt_u32(static_cast<unsigned>(mask)));
+    }
+
+    // In-place partition of a[0, n), n >= 16. The first and last vectors are
+    // set aside, which leaves 16 free slots between the read and write heads;
+    // reading from the side with less free space keeps at least 8 free slots
+    // in front of both write heads, so full-vector stores never overwrite
+    // unread data
+    SIMD_SORT_TARGET static size_t partition(T* a, size_t n, T pivotValue, bool orEqual) {
+        Vec pivot = Ops::set1(pivotValue);
+        Vec first = Ops::load(a);
+        Vec last = Ops::load(a + n - 8);
+        size_t readLeft = 8;
+        size_t readRight = n - 8;
+        size_t writeLeft = 0;
+        size_t writeRight = n;
+        while (readRight - readLeft >= 8) {
+            Vec v;
+            if (readLeft - writeLeft <= writeRight - readRight) {
+                v = Ops::load(a + readLeft);
+                readLeft += 8;
+            } else {
+                readRight -= 8;
+                v = Ops::load(a + readRight);
+            }
+            size_t below = partitionVector(v, pivot, orEqual, a + writeLeft, a + writeRight);
+            writeLeft += below;
+            writeRight -= 8 - below;
+        }
+
+        // The unread remainder and the two saved vectors fill the gap exactly
+        T rest[24];
+        size_t count = readRight - readLeft;
+        std::copy(a + readLeft, a + readRight, rest);
+        Ops::store(rest + count, first);
+        Ops::store(rest + count + 8, last);
+        count += 16;
+        for (size_t i = 0; i < count; i++) {
+            if (orEqual ? !(pivotValue < rest[i]) : rest[i] < pivotValue) {
+                a[writeLeft++] = rest[i];
+            } else {
+                a[--writeRight] = rest[i];
+            }
+        }
+        return writeLeft;
+    }
+};
+
+#endif // SIMD_SORT_AVX2
+
+// Block sort, merge and partition kernels used by the SIMD merge sort, the
+// vector quick sort and as the base case of Merge Sort and Quick Sort. int and
+// float use AVX2 when the CPU has it; every other case runs the scalar fallback.
+template <typename T>
+class SimdSort {
+public:
+    // Largest block sortBlock handles
+    static constexpr size_t blockSize = 64;
+
+    // True when T has vector kernels and the CPU can run them
+    static bool available() {
+#ifdef SIMD_SORT_AVX2
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+            static const bool supported = cpuHasAvx2();
+            return supported;
+        }
+#endif
+        return false;
+    }
+
+    // Sort a[0, n) for n <= blockSize
+    static void sortBlock(T* a, size_t n) {
+#ifdef SIMD_SORT_AVX2
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+            if (available()) {
+                Avx2Kernels<T>::sortBlock(a, n);
+                return;
+            }
+        }
+#endif
+        for (size_t i = 1; i < n; i++) {
+            T key = a[i];
+            size_t j = i;
+            while (j > 0 && key < a[j - 1]) {
+                a[j] = a[j - 1];
+                j--;
+            }
+            a[j] = key;
+        }
+    }
+
+    // Merge the sorted runs left and right into output, which must not overlap them
+    static void mergeRuns(const T* left, size_t leftSize, const T* right, size_t rightSize, T* output) {
+#ifdef SIMD_SORT_AVX2
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+            if (available()) {
+                Avx2Kernels<T>::mergeRuns(left, leftSize, right, rightSize, output, scalarMerge);
+                return;
+            }
+        }
+#endif
+        scalarMerge(left, leftSize, right, rightSize, output);
+    }
+
+    // Reorder a[0, n) so the elements below the pivot (not above it when
+    // orEqual is set) come first; returns how many there are
+    static size_t partition(T* a, size_t n, T pivot, bool orEqual) {
+#ifdef SIMD_SORT_AVX2
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+            if (n >= 16 && available()) {
+                return Avx2Kernels<T>::partition(a, n, pivot, orEqual);
+            }
+        }
+#endif
+        T* split = orEqual ? std::partition(a, a + n, [&pivot](const T& x) { return !(pivot < x); })
+                           : std::partition(a, a + n, [&pivot](const T& x) { return x < pivot; });
+        return static_cast<size_t>(split - a);
+    }
+
+private:
+    static void scalarMerge(const T* left, size_t leftSize, const T* right, size_t rightSize, T* output) {
+        size_t i = 0;
+        size_t j = 0;
+        while (i < leftSize && j < rightSize) {
+            *output++ = right[j] < left[i] ? right[j++] : left[i++];
+        }
+        output = std::copy(left + i, left + leftSize, output);
+        std::copy(right + j, right + rightSize, output);
+    }
+
+#ifdef SIMD_SORT_AVX2
+    static bool cpuHasAvx2() {
+#if defined(__GNUC__)
+        return __builtin_cpu_supports("avx2");
+#else
+        return true; // Built with /arch:AVX2
+#endif
+    }
+#endif
+};
+
+#endif // AIZOPROJEKT_SIMDSORT_H
@@ -1,20 +1,40 @@
 #ifndef AIZOPROJEKT_SORTER_H
 #define AIZOPROJEKT_SORTER_H
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "DynamicArray.h"
+#include "GapSequence.h"
+#include "RadixKey.h"
+#include "SimdSort.h"
+#include "ThreadPool.h"
 
+// All algorithms work on DynamicArray::operator[] / data(), so the bounds
+// checks follow DynamicArray::checkedAccess (on in debug, off in release).
 template <typename T>
 class Sorter {
 public:
     // Bubble Sort
     static void bubbleSort(DynamicArray<T>* data) {
-        for (size_t i = 0; i < data->getSize() - 1; ++i) {
-            for (size_t j = 0; j < data->getSize() - i - 1; ++j) {
-                if (data->get(j) > data->get(j + 1)) {
-                    T temp = data->get(j);
-                    data->set(j, data->get(j + 1));
-                    data->set(j + 1, temp);
+        DynamicArray<T>& a = *data;
+        if (a.getSize() < 2) return;
+        data->advise(AccessPattern::Sequential);
+        for (size_t i = 0; i < a.getSize() - 1; ++i) {
+            for (size_t j = 0; j < a.getSize() - i - 1; ++j) {
+                if (a[j] > a[j + 1]) {
+                    std::swap(a[j], a[j + 1]);
                 }
             }
         }
@@ -22,8 +42,9 @@ public:
 
     // Drunk Bubble Sort
     static void drunkBubbleSort(DynamicArray<T>* data, int drunkLevel) {
-
-        size_t n = data->getSize();
+        DynamicArray<T>& a = *data;
+        size_t n = a.getSize();
+        if (n < 2) return;
 
         // Pijana część — działa z błędami, losowo
         for (size_t i = 0; i < n - 1; ++i) {
@@ -36,16 +57,12 @@ public:
                 }
 
                 // Normalna zamiana
-                if (data->get(j) > data->get(j + 1)) {
-                    T temp = data->get(j);
-                    data->set(j, data->get(j + 1));
-                    data->set(j + 1, temp);
+                if (a[j] > a[j + 1]) {
+                    std::swap(a[j], a[j + 1]);
                 } else {
                     // Może przypadkowo zamienimy dobry porządek?
                     if (randomValue < drunkLevel * 2) {
-                        T temp = data->get(j);
-                        data->set(j, data->get(j + 1));
-                        data->set(j + 1, temp);
+                        std::swap(a[j], a[j + 1]);
                     }
                 }
             }
@@ -56,10 +73,8 @@ public:
         while (!sorted) {
             sorted = true;
             for (size_t j = 0; j < n - 1; ++j) {
-                if (data->get(j) > data->get(j + 1)) {
-                    T temp = data->get(j);
-                    data->set(j, data->get(j + 1));
-                    data->set(j + 1, temp);
+                if (a[j] > a[j + 1]) {
+                    std::swap(a[j], a[j + 1]);
                     sorted = false;
                 }
             }
@@ -68,33 +83,41 @@ public:
 
     // Merge Sort
     static void mergeSort(DynamicArray<T>* data) {
+        if (data->getSize() < 2) return;
+        data->advise(AccessPattern::Sequential);
         mergeSortHelper(data, 0, data->getSize() - 1);
     }
 
     // Insert Sort
     static void insertSort(DynamicArray<T>* data) {
-        size_t n = data->getSize();
+        DynamicArray<T>& a = *data;
+        data->advise(AccessPattern::Sequential);
+        size_t n = a.getSize();
         if (n <= 1) return;
 
         for (size_t i = 1; i < n; i++) {
-            T key = data->get(i);
+            T key = a[i];
             size_t j = i;
 
-            // Przesuwaj elementy większe od key w lewo
-            while (j > 0 && data->get(j - 1) > key) {
-                data->set(j, data->get(j - 1));
+            // Znajdź miejsce dla key, elementy przesuwamy jednym blokiem
+            while (j > 0 && a[j - 1] > key) {
                 j--;
             }
-            data->set(j, key);
+            if (j < i) {
+                data->shiftRange(j, i, j + 1);
+                a[j] = key;
+            }
         }
     }
 
     // Binary Insert Sort
     static void binaryInsertSort(DynamicArray<T>* data) {
-        if (data->getSize() <= 1) return;
+        DynamicArray<T>& a = *data;
+        data->advise(AccessPattern::Normal); // binary search probes, then a sequential shift
+        if (a.getSize() <= 1) return;
 
-        for (size_t i = 1; i < data->getSize(); i++) {
-            T key = data->get(i);
+        for (size_t i = 1; i < a.getSize(); i++) {
+            T key = a[i];
 
             // Find the correct position using binary search
             size_t left = 0;
@@ -102,17 +125,18 @@ public:
 
             while (left < right) {
                 size_t mid = left + (right - left) / 2;
-                if (data->get(mid) <= key) {
+                if (a[mid] <= key) {
                     left = mid + 1;
                 } else {
                     right = mid;
                 }
             }
 
-            // If the element should be inserted before its current position
+            // If the element should be inserted before its current position,
+            // shift the block [left, i) one slot right in a single move
             if (left < i) {
-                data->deleteAt(i);
-                data->insert(left, key);
+                data->shiftRange(left, i, left + 1);
+                a[left] = key;
             }
         }
     }
@@ -126,10 +150,20 @@ public:
 //        }
 //    }
 
+    // Quick Sort of the whole array (partitioning scans sequentially)
+    static void quickSort(DynamicArray<T>* data) {
+        data->advise(AccessPattern::Sequential);
+        quickSort(data, 0, (ptrdiff_t) data->getSize() - 1);
+    }
+
     // Quick Sort new (with optimal tail recursion)
-    static void quickSort(DynamicArray<T>* data, int low, int high) {
+    static void quickSort(DynamicArray<T>* data, ptrdiff_t low, ptrdiff_t high) {
         while (low < high) {
-            int pi = partition(data, low, high);
+            if (high - low < (ptrdiff_t) SimdSort<T>::blockSize && SimdSort<T>::available()) {
+                SimdSort<T>::sortBlock(data->data() + low, high - low + 1); // Vector sorting network
+                return;
+            }
+            ptrdiff_t pi = partition(data, low, high);
 
             // Recur on the smaller partition first
             if (pi - low < high - pi) {
@@ -143,17 +177,17 @@ public:
     }
 
     // Quick Sort descending
-    static void quickSortDesc(DynamicArray<T>* data, int low, int high) {
+    static void quickSortDesc(DynamicArray<T>* data, ptrdiff_t low, ptrdiff_t high) {
         if (low < high) {
-            int pi = partitionDesc(data, low, high);
+            ptrdiff_t pi = partitionDesc(data, low, high);
             quickSortDesc(data, low, pi - 1);
             quickSortDesc(data, pi + 1, high);
         }
     }
 
-    static void drunkQuickSort(DynamicArray<T>* data, int low, int high, int drunkLevel) {
+    static void drunkQuickSort(DynamicArray<T>* data, ptrdiff_t low, ptrdiff_t high, int drunkLevel) {
         if (low < high) {
-            int pi = drunkPartition(data, low, high, drunkLevel);
+            ptrdiff_t pi = drunkPartition(data, low, high, drunkLevel);
 
             int newDrunkLevel = std::max(0, drunkLevel - 1);
 
@@ -165,37 +199,562 @@ public:
 
     // Heap Sort
     static void heapSort(DynamicArray<T>* data) {
-        int n = data->getSize();
-        for (int i = n / 2 - 1; i >= 0; i--) {
+        DynamicArray<T>& a = *data;
+        size_t n = a.getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Random); // both heap phases jump between levels
+        for (size_t i = n / 2; i-- > 0;) {
             heapify(data, n, i);
         }
-        for (int i = n - 1; i > 0; i--) {
-            T temp = data->get(0);
-            data->set(0, data->get(i));
-            data->set(i, temp);
+        for (size_t i = n - 1; i > 0; i--) {
+            std::swap(a[0], a[i]);
             heapify(data, i, 0);
         }
     }
 
-    // Shell Sort
-    static void shellSort(DynamicArray<T>* data) {
-        int n = data->getSize();
-        for (int gap = n / 2; gap > 0; gap /= 2) {
-            for (int i = gap; i < n; i++) {
-                T temp = data->get(i);
-                int j;
-                for (j = i; j >= gap && data->get(j - gap) > temp; j -= gap) {
-                    data->set(j, data->get(j - gap));
+    // Shell Sort with the given gap sequence (Shell's n/2, n/4, ... by default)
+    static void shellSort(DynamicArray<T>* data, GapSequence sequence = GapSequence::Shell) {
+        DynamicArray<T>& a = *data;
+        size_t n = a.getSize();
+        // Wide gaps touch a new page per step, narrow ones stream through memory
+        AccessPattern pattern = AccessPattern::Random;
+        data->advise(pattern);
+        for (size_t gap : GapSequences::forSize(sequence, n)) {
+            if (pattern == AccessPattern::Random && gap * sizeof(T) < 4096) {
+                pattern = AccessPattern::Sequential;
+                data->advise(pattern);
+            }
+            for (size_t i = gap; i < n; i++) {
+                T temp = a[i];
+                size_t j;
+                for (j = i; j >= gap && a[j - gap] > temp; j -= gap) {
+                    a[j] = a[j - gap];
+                }
+                a[j] = temp;
+            }
+        }
+    }
+
+    // Intro Sort: quick sort with median-of-three (ninther for large ranges)
+    // pivots, heap sort once the recursion gets too deep and insertion sort
+    // for small partitions, so it stays O(n log n) on every distribution
+    static void introSort(DynamicArray<T>* data) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        introSortLoop(*data, 0, n, 2 * floorLog2(n));
+    }
+
+    // Parallel Quick Sort: after each partition one side becomes a stealable
+    // task on the pool while the current thread keeps the other; ranges below
+    // parallelCutoff are finished sequentially with Intro Sort
+    static void parallelQuickSort(DynamicArray<T>* data, ThreadPool& pool) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        ThreadPool::TaskGroup group;
+        parallelQuickSortTask(*data, 0, n, 2 * floorLog2(n), pool, group);
+        pool.wait(group);
+    }
+
+    // Parallel Merge Sort: both halves are sorted as concurrent tasks and every
+    // large merge is split across the pool with merge-path (co-rank) partitioning
+    static void parallelMergeSort(DynamicArray<T>* data, ThreadPool& pool) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        std::unique_ptr<T[]> buffer(new T[n]);
+        parallelMergeSortTask(data->data(), buffer.get(), 0, n, pool);
+    }
+
+    // Parallel Sample Sort: p - 1 splitters for the p pool threads come from a
+    // seeded random sample, oversampled sampleOversampling * log2(n) times per
+    // bucket. Duplicate splitters are collapsed and every splitter gets an
+    // equality bucket next to the range bucket before it, so keys equal to a
+    // splitter are never sorted again and heavy duplicates cannot pile up in
+    // one bucket. One parallel pass classifies a fixed block per thread, a
+    // second scatters the blocks into the buckets, the range buckets are
+    // sorted concurrently with bucketSort and p tasks copy equal slices of
+    // the result back. Nothing depends on task scheduling, so a fixed seed
+    // and thread count give the same buckets on every run
+    static void parallelSampleSort(DynamicArray<T>* data, ThreadPool& pool,
+                                   const std::function<void(DynamicArray<T>*)>& bucketSort,
+                                   std::uint64_t seed = sampleSortSeed) {
+        size_t n = data->getSize();
+        size_t p = std::min(pool.size(), maxSampleBuckets / 2);
+        if (n < parallelCutoff || p < 2) {
+            bucketSort(data);
+            return;
+        }
+        data->advise(AccessPattern::Sequential);
+
+        // Splitters are every oversampling-th element of the sorted sample
+        size_t oversampling = sampleOversampling * floorLog2(n);
+        std::mt19937_64 random(seed);
+        std::uniform_int_distribution<size_t> position(0, n - 1);
+        std::vector<T> sample(p * oversampling);
+        for (T& value : sample) {
+            value = (*data)[position(random)];
+        }
+        std::sort(sample.begin(), sample.end());
+        std::vector<T> splitters;
+        for (size_t i = 1; i < p; i++) {
+            const T& splitter = sample[i * oversampling];
+            if (splitters.empty() || splitters.back() < splitter) {
+                splitters.push_back(splitter);
+            }
+        }
+
+        // Classify: thread t owns block [t * n / p, (t + 1) * n / p). Bucket
+        // 2j holds the keys strictly between splitters j - 1 and j, bucket
+        // 2j + 1 the keys equal to splitter j
+        size_t bucketCount = 2 * splitters.size() + 1;
+        const T* values = data->data();
+        std::vector<std::uint16_t> oracle(n);
+        std::vector<size_t> counts(p * bucketCount); // counts[t * bucketCount + b]
+        ThreadPool::TaskGroup group;
+        for (size_t t = 0; t < p; t++) {
+            pool.submit(group, [&, t] {
+                std::vector<size_t> blockCounts(bucketCount);
+                for (size_t i = t * n / p; i < (t + 1) * n / p; i++) {
+                    size_t above = std::upper_bound(splitters.begin(), splitters.end(), values[i]) - splitters.begin();
+                    bool equal = above > 0 && !(splitters[above - 1] < values[i]);
+                    size_t bucket = 2 * above - (equal ? 1 : 0);
+                    oracle[i] = (std::uint16_t) bucket;
+                    blockCounts[bucket]++;
+                }
+                std::copy(blockCounts.begin(), blockCounts.end(), counts.begin() + t * bucketCount);
+            });
+        }
+        pool.wait(group);
+
+        // Bucket b starts at bucketStart[b] in the output; block t writes its
+        // part of the bucket after the parts of blocks 0..t-1
+        std::vector<size_t> bucketStart(bucketCount + 1);
+        std::vector<size_t> blockOffset(p * bucketCount);
+        for (size_t b = 0; b < bucketCount; b++) {
+            size_t size = 0;
+            for (size_t t = 0; t < p; t++) {
+                blockOffset[t * bucketCount + b] = size;
+                size += counts[t * bucketCount + b];
+            }
+            bucketStart[b + 1] = bucketStart[b] + size;
+        }
+
+        // Scratch comes from the heap: the caller's resource may hold only its own storage
+        std::vector<DynamicArray<T>> buckets;
+        std::vector<T*> targets(bucketCount);
+        buckets.reserve(bucketCount);
+        for (size_t b = 0; b < bucketCount; b++) {
+            size_t size = bucketStart[b + 1] - bucketStart[b];
+            buckets.emplace_back(std::max<size_t>(size, 1), MemoryResource::heap());
+            targets[b] = buckets[b].uninitializedTail(size);
+        }
+
+        for (size_t t = 0; t < p; t++) {
+            pool.submit(group, [&, t] {
+                std::vector<size_t> next(blockOffset.begin() + t * bucketCount,
+                                         blockOffset.begin() + (t + 1) * bucketCount);
+                for (size_t i = t * n / p; i < (t + 1) * n / p; i++) {
+                    size_t bucket = oracle[i];
+                    targets[bucket][next[bucket]++] = values[i];
+                }
+            });
+        }
+        pool.wait(group);
+
+        // Sort the range buckets concurrently; equality buckets are already in order
+        for (size_t b = 0; b < bucketCount; b++) {
+            buckets[b].commit(bucketStart[b + 1] - bucketStart[b]);
+            if (b % 2 == 0 && buckets[b].getSize() > 1) {
+                pool.submit(group, [&, b] { bucketSort(&buckets[b]); });
+            }
+        }
+        pool.wait(group);
+
+        // Copy back in p equal slices of the output, however the buckets are sized
+        T* output = data->data();
+        for (size_t t = 0; t < p; t++) {
+            pool.submit(group, [&, t] {
+                size_t begin = t * n / p;
+                size_t end = (t + 1) * n / p;
+                size_t b = std::upper_bound(bucketStart.begin(), bucketStart.end(), begin) - bucketStart.begin() - 1;
+                while (begin < end) {
+                    size_t stop = std::min(end, bucketStart[b + 1]);
+                    const T* source = buckets[b].data();
+                    std::copy(source + (begin - bucketStart[b]), source + (stop - bucketStart[b]), output + begin);
+                    begin = stop;
+                    b++;
+                }
+            });
+        }
+        pool.wait(group);
+    }
+
+    // Ping-pong Merge Sort: one auxiliary buffer allocated up front; source and
+    // destination swap roles on every level, so merged runs are never copied back
+    static void pingPongMergeSort(DynamicArray<T>* data) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        T* a = data->data();
+        std::unique_ptr<T[]> buffer(new T[n]);
+        std::copy(a, a + n, buffer.get());
+        mergeSortInto(buffer.get(), a, 0, n);
+    }
+
+    // Bottom-up Merge Sort: iterative passes over runs of doubling width,
+    // alternating between the array and one auxiliary buffer
+    static void bottomUpMergeSort(DynamicArray<T>* data) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        T* a = data->data();
+        for (size_t low = 0; low < n; low += introCutoff) {
+            insertionSortRaw(a, low, std::min(n, low + introCutoff));
+        }
+
+        std::unique_ptr<T[]> buffer(new T[n]);
+        T* source = a;
+        T* target = buffer.get();
+        for (size_t width = introCutoff; width < n; width *= 2) {
+            for (size_t low = 0; low < n; low += 2 * width) {
+                size_t mid = std::min(n, low + width);
+                size_t high = std::min(n, low + 2 * width);
+                mergeRuns(source + low, mid - low, source + mid, high - mid, target + low);
+            }
+            std::swap(source, target);
+        }
+        if (source != a) {
+            std::copy(source, source + n, a); // Odd number of passes ended in the buffer
+        }
+    }
+
+    // LSD Radix Sort for integer and floating point data: 11-bit digits (8 for
+    // char), the histograms of all passes come from a single scan, and passes
+    // where every key has the same digit are skipped
+    static void lsdRadixSort(DynamicArray<T>* data) {
+        if constexpr (!RadixKey<T>::supported) {
+            throw std::invalid_argument("Radix sort supports only integer and floating point data");
+        } else {
+            using Key = typename RadixKey<T>::Key;
+            constexpr size_t keyBits = sizeof(Key) * 8;
+            constexpr size_t digitBits = keyBits <= 8 ? 8 : 11;
+            constexpr size_t buckets = size_t(1) << digitBits;
+            constexpr size_t passes = (keyBits + digitBits - 1) / digitBits;
+
+            size_t n = data->getSize();
+            if (n < 2) return;
+            data->advise(AccessPattern::Sequential);
+            T* a = data->data();
+
+            std::unique_ptr<size_t[]> counts(new size_t[passes * buckets]());
+            for (size_t i = 0; i < n; i++) {
+                Key key = RadixKey<T>::toKey(a[i]);
+                for (size_t pass = 0; pass < passes; pass++) {
+                    counts[pass * buckets + ((key >> (pass * digitBits)) & (buckets - 1))]++;
                 }
-                data->set(j, temp);
             }
+
+            std::unique_ptr<T[]> buffer(new T[n]);
+            T* source = a;
+            T* target = buffer.get();
+            for (size_t pass = 0; pass < passes; pass++) {
+                size_t shift = pass * digitBits;
+                size_t* count = counts.get() + pass * buckets;
+
+                // A digit shared by every key does not change the order
+                if (count[(RadixKey<T>::toKey(source[0]) >> shift) & (buckets - 1)] == n) {
+                    continue;
+                }
+
+                size_t offset = 0;
+                for (size_t bucket = 0; bucket < buckets; bucket++) {
+                    size_t bucketSize = count[bucket];
+                    count[bucket] = offset;
+                    offset += bucketSize;
+                }
+                for (size_t i = 0; i < n; i++) {
+                    target[count[(RadixKey<T>::toKey(source[i]) >> shift) & (buckets - 1)]++] = source[i];
+                }
+                std::swap(source, target);
+            }
+            if (source != a) {
+                std::copy(source, source + n, a);
+            }
+        }
+    }
+
+    // In-place MSD radix sort (American flag sort): 8-bit digits from the most
+    // significant one, elements are cycled straight into their buckets so no
+    // scratch buffer is needed; buckets of 32 elements or fewer go to insertion sort
+    static void americanFlagSort(DynamicArray<T>* data) {
+        if constexpr (!RadixKey<T>::supported) {
+            throw std::invalid_argument("Radix sort supports only integer and floating point data");
+        } else {
+            size_t n = data->getSize();
+            if (n < 2) return;
+            data->advise(AccessPattern::Random);
+            americanFlagSortRange(data->data(), n, sizeof(typename RadixKey<T>::Key) * 8 - 8);
+        }
+    }
+
+    // Counting Sort for 1-byte integers (char): one histogram pass, then every
+    // value is written back as a single memset run, so the sort becomes a
+    // memory-bandwidth-bound scan
+    static void countingSort(DynamicArray<T>* data) {
+        if constexpr (!(std::is_integral_v<T> && sizeof(T) == 1)) {
+            throw std::invalid_argument("Counting sort supports only char data");
+        } else {
+            size_t n = data->getSize();
+            if (n < 2) return;
+            data->advise(AccessPattern::Sequential);
+            auto* bytes = reinterpret_cast<unsigned char*>(data->data());
+
+            size_t counts[256];
+            byteHistogram(bytes, n, counts);
+
+            // Visit byte values in key order, so signed chars start at 0x80
+            size_t position = 0;
+            for (size_t key = 0; key < 256; key++) {
+                size_t byte = key ^ RadixKey<T>::signBit;
+                std::memset(bytes + position, static_cast<int>(byte), counts[byte]);
+                position += counts[byte];
+            }
+        }
+    }
+
+    // Picks an algorithm from the element type and size: Counting Sort for
+    // char, LSD Radix Sort for large int/float arrays, Intro Sort otherwise
+    static void autoSort(DynamicArray<T>* data) {
+        if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+            countingSort(data);
+        } else if constexpr (RadixKey<T>::supported) {
+            if (data->getSize() >= autoRadixThreshold) {
+                lsdRadixSort(data);
+            } else {
+                introSort(data);
+            }
+        } else {
+            introSort(data);
         }
     }
 
+    // SIMD Merge Sort: blocks of 64 are sorted by a vector sorting network,
+    // then bottom-up passes merge them with bitonic vector merges, alternating
+    // between the array and one buffer. Types or CPUs without vector kernels
+    // run the same passes on the scalar fallbacks of SimdSort
+    static void simdMergeSort(DynamicArray<T>* data) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        T* a = data->data();
+        constexpr size_t block = SimdSort<T>::blockSize;
+        for (size_t low = 0; low < n; low += block) {
+            SimdSort<T>::sortBlock(a + low, std::min(block, n - low));
+        }
+
+        std::unique_ptr<T[]> buffer(new T[n]);
+        T* source = a;
+        T* target = buffer.get();
+        for (size_t width = block; width < n; width *= 2) {
+            for (size_t low = 0; low < n; low += 2 * width) {
+                size_t mid = std::min(n, low + width);
+                size_t high = std::min(n, low + 2 * width);
+                SimdSort<T>::mergeRuns(source + low, mid - low, source + mid, high - mid, target + low);
+            }
+            std::swap(source, target);
+        }
+        if (source != a) {
+            std::copy(source, source + n, a);
+        }
+    }
+
+    // Vector Quick Sort: intro sort whose partition step runs on SimdSort,
+    // comparing 8 elements against the pivot at once and writing both sides
+    // through one permutation-table shuffle instead of a branch per element.
+    // Ranges of 64 or fewer go to the vector sorting network
+    static void vectorQuickSort(DynamicArray<T>* data) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        vectorQuickSortLoop(*data, 0, n, 2 * floorLog2(n));
+    }
+
+    // Block Quick Sort: intro sort with BlockQuicksort partitioning. Each side
+    // records the offsets of its misplaced elements for a block of 128 with a
+    // branch-free loop and then swaps them in pairs, so the comparisons never
+    // feed a conditional jump
+    static void blockQuickSort(DynamicArray<T>* data) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        blockQuickSortLoop(*data, 0, n, 2 * floorLog2(n));
+    }
+
+    // Powersort: stable natural merge sort. Existing ascending runs are used
+    // as they are, strictly descending ones are reversed, and runs shorter than
+    // the minimum run length are extended with insertion sort. Runs are merged
+    // in the order given by their powersort node powers, and merges switch to
+    // galloping when one run keeps winning (as in TimSort). Sorted input costs
+    // a single O(n) scan
+    static void powerSort(DynamicArray<T>* data) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        T* a = data->data();
+        size_t minRun = minRunLength(n);
+        MergeState state;
+        std::vector<Run> runs; // Pending runs; runs[i].power belongs to the boundary after run i
+        for (size_t start = 0; start < n;) {
+            size_t length = countRunAndMakeAscending(a, start, n);
+            if (length < minRun) {
+                size_t forced = std::min(minRun, n - start);
+                insertionSortRaw(a, start, start + forced);
+                length = forced;
+            }
+
+            if (!runs.empty()) {
+                unsigned power = nodePower(runs.back().start, runs.back().length, length, n);
+                while (runs.size() > 1 && runs[runs.size() - 2].power > power) {
+                    mergeTopRuns(a, runs, state);
+                }
+                runs.back().power = power;
+            }
+            runs.push_back({start, length, 0});
+            start += length;
+        }
+        while (runs.size() > 1) {
+            mergeTopRuns(a, runs, state);
+        }
+    }
+
+    // d-ary Heap Sort (D = 4 or 8): the D children of a node are adjacent, so
+    // one or two cache lines hold a whole sibling group and the heap is
+    // log_D(n) levels deep instead of log_2(n). Sift-down is iterative and
+    // moves a hole instead of swapping, the sort-down phase uses Floyd's
+    // bottom-up variant, and the grandchildren are prefetched while the
+    // children are compared
+    template <size_t D>
+    static void dAryHeapSort(DynamicArray<T>* data) {
+        static_assert(D >= 2, "A heap needs at least two children per node");
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Random);
+
+        T* a = data->data();
+        for (size_t i = (n - 2) / D + 1; i-- > 0;) {
+            dArySiftDown<D>(a, n, i);
+        }
+        for (size_t end = n - 1; end > 0; end--) {
+            T value = a[end];
+            a[end] = a[0];
+            dArySiftBottomUp<D>(a, end, value);
+        }
+    }
+
+    // Dual-Pivot Quick Sort (Yaroslavskiy): two pivots split each range into
+    // < p, p..q and > q in a single pass, touching memory fewer times than
+    // single-pivot partitioning. The pivots are the lowRank-th and highRank-th
+    // (1-based) of five evenly spaced elements sorted in place; ranges of
+    // at most insertionCutoff elements are finished by insertion sort
+    static void dualPivotQuickSort(DynamicArray<T>* data, int lowRank = 2, int highRank = 4,
+                                   size_t insertionCutoff = dualPivotCutoff) {
+        if (lowRank < 1 || lowRank >= highRank || highRank > (int) dualPivotSample) {
+            throw std::invalid_argument("Dual-pivot ranks must satisfy 1 <= low < high <= 5");
+        }
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        DualPivotSettings settings = {(size_t) lowRank - 1, (size_t) highRank - 1,
+                                      std::max(insertionCutoff, dualPivotSample)};
+        dualPivotQuickSortLoop(*data, 0, n, 2 * floorLog2(n), settings);
+    }
+
+    // 3-Way Quick Sort with Bentley-McIlroy partitioning: keys equal to the
+    // pivot are parked at both ends during the scan and swapped into the
+    // middle afterwards, so they are never part of a recursive call. Inputs
+    // with few distinct keys (char, low-cardinality data) take O(n log k)
+    static void threeWayQuickSort(DynamicArray<T>* data) {
+        size_t n = data->getSize();
+        if (n < 2) return;
+        data->advise(AccessPattern::Sequential);
+
+        threeWayQuickSortLoop(*data, 0, n, 2 * floorLog2(n));
+    }
+
+    // Rearrange the array so (*data)[k] holds the element a full sort would
+    // put there, with nothing greater before it and nothing smaller after it.
+    // Introselect with Floyd-Rivest sampling on large ranges: expected
+    // O(n), heap sort of the remaining range when the depth limit runs out
+    static void nthElement(DynamicArray<T>* data, size_t k) {
+        size_t n = data->getSize();
+        if (k >= n) {
+            throw std::out_of_range("nthElement: rank " + std::to_string(k) + " is past the end of the array");
+        }
+        selectLoop(*data, 0, n, k, 2 * floorLog2(n));
+    }
+
+    // Sort only the k smallest elements into data[0, k); the order of the
+    // rest is unspecified. O(n + k log k): one selection, then Intro Sort of
+    // the elements in front of the k-th
+    static void partialSort(DynamicArray<T>* data, size_t k) {
+        size_t n = data->getSize();
+        if (k == 0 || n < 2) return;
+
+        if (k >= n) {
+            introSortLoop(*data, 0, n, 2 * floorLog2(n));
+            return;
+        }
+        selectLoop(*data, 0, n, k - 1, 2 * floorLog2(n));
+        introSortLoop(*data, 0, k - 1, 2 * floorLog2(k));
+    }
+
+    // Store the k largest elements of data into result in descending order,
+    // leaving data untouched. A single pass keeps a min-heap of the best k
+    // seen so far: O(n log k) time and O(k) memory
+    static void topK(const DynamicArray<T>* data, size_t k, DynamicArray<T>* result) {
+        size_t n = data->getSize();
+        k = std::min(k, n);
+        result->clear();
+        if (k == 0) return;
+
+        T* heap = result->uninitializedTail(k);
+        const T* values = data->data();
+        std::copy(values, values + k, heap);
+        for (size_t i = k / 2; i-- > 0;) {
+            minHeapSiftDown(heap, k, i);
+        }
+        for (size_t i = k; i < n; i++) {
+            if (heap[0] < values[i]) {
+                heap[0] = values[i];
+                minHeapSiftDown(heap, k, 0);
+            }
+        }
+
+        // Popping the minimum to the back leaves the largest element first
+        for (size_t i = k - 1; i > 0; i--) {
+            std::swap(heap[0], heap[i]);
+            minHeapSiftDown(heap, i, 0);
+        }
+        result->commit(k);
+    }
+
     // Check if the array is sorted
     static void isCorrect(const DynamicArray<T>* data) {
-        for (size_t i = 0; i < data->getSize() - 1; ++i) {
-            if (data->get(i) > data->get(i + 1)) {
+        const DynamicArray<T>& a = *data;
+        for (size_t i = 1; i < a.getSize(); ++i) {
+            if (a[i - 1] > a[i]) {
                 std::cout << "Array is not sorted correctly." << std::endl;
             }
         }
@@ -203,8 +762,1036 @@ public:
     }
 
 private:
+    // Partitions at most this long are left to insertion sort
+    static constexpr size_t introCutoff = 16;
+
+    // Elements sampled for the two pivots of Dual-Pivot Quick Sort
+    static constexpr size_t dualPivotSample = 5;
+
+    // Default insertion sort cutoff of Dual-Pivot Quick Sort (Yaroslavskiy 2009)
+    static constexpr size_t dualPivotCutoff = 27;
+
+    struct DualPivotSettings {
+        size_t lowRank; // 0-based positions of the pivots in the sorted sample
+        size_t highRank;
+        size_t cutoff;
+    };
+
+    // Ranges shorter than this are not worth a task of their own
+    static constexpr size_t parallelCutoff = 1 << 14;
+
+    // Sample elements per bucket and log2(n) in Parallel Sample Sort
+    static constexpr size_t sampleOversampling = 16;
+
+    // Bucket indices (two per splitter) are stored in 16 bits
+    static constexpr size_t maxSampleBuckets = 1 << 16;
+
+    // Default sampling seed of Parallel Sample Sort
+    static constexpr std::uint64_t sampleSortSeed = 42;
+
+    static size_t floorLog2(size_t n) {
+        size_t log = 0;
+        while (n > 1) {
+            n >>= 1;
+            log++;
+        }
+        return log;
+    }
+
+    // One task of Parallel Quick Sort over [low, high)
+    static void parallelQuickSortTask(DynamicArray<T>& a, size_t low, size_t high, size_t depthLimit,
+                                      ThreadPool& pool, ThreadPool::TaskGroup& group) {
+        while (high - low > parallelCutoff) {
+            if (depthLimit == 0) {
+                heapSortRange(a, low, high);
+                return;
+            }
+            depthLimit--;
+
+            size_t pi = introPartition(a, low, high);
+
+            // Hand the smaller side to the pool and keep partitioning the larger one
+            if (pi - low < high - pi) {
+                pool.submit(group, [&a, low, pi, depthLimit, &pool, &group] {
+                    parallelQuickSortTask(a, low, pi, depthLimit, pool, group);
+                });
+                low = pi + 1;
+            } else {
+                pool.submit(group, [&a, pi, high, depthLimit, &pool, &group] {
+                    parallelQuickSortTask(a, pi + 1, high, depthLimit, pool, group);
+                });
+                high = pi;
+            }
+        }
+        introSortLoop(a, low, high, depthLimit);
+    }
+
+    // Vector Quick Sort over [low, high): AVX2 partitions down to SimdSort blocks
+    static void vectorQuickSortLoop(DynamicArray<T>& a, size_t low, size_t high, size_t depthLimit) {
+        while (high - low > SimdSort<T>::blockSize) {
+            if (depthLimit == 0) {
+                heapSortRange(a, low, high);
+                return;
+            }
+            depthLimit--;
+
+            T pivot = a[choosePivot(a, low, high)];
+            size_t split = low + SimdSort<T>::partition(a.data() + low, high - low, pivot, false);
+            if (split == low) {
+                // Nothing is below the pivot: the keys equal to it are in place
+                low += SimdSort<T>::partition(a.data() + low, high - low, pivot, true);
+                continue;
+            }
+
+            // Recur on the smaller partition first
+            if (split - low < high - split) {
+                vectorQuickSortLoop(a, low, split, depthLimit);
+                low = split;
+            } else {
+                vectorQuickSortLoop(a, split, high, depthLimit);
+                high = split;
+            }
+        }
+        SimdSort<T>::sortBlock(a.data() + low, high - low);
+    }
+
+    static constexpr size_t partitionBlock = 128;
+
+    static void blockQuickSortLoop(DynamicArray<T>& a, size_t low, size_t high, size_t depthLimit) {
+        while (high - low > introCutoff) {
+            if (depthLimit == 0) {
+                heapSortRange(a, low, high);
+                return;
+            }
+            depthLimit--;
+
+            size_t pi = blockPartition(a, low, high);
+
+            // Recur on the smaller partition first
+            if (pi - low < high - pi) {
+                blockQuickSortLoop(a, low, pi, depthLimit);
+                low = pi + 1;
+            } else {
+                blockQuickSortLoop(a, pi + 1, high, depthLimit);
+                high = pi;
+            }
+        }
+        insertionSortRange(a, low, high);
+    }
+
+    // Hoare partition of a[low, high) around the chosen pivot, with the bulk
+    // of the range processed in blocks: elements not below the pivot on the
+    // left and not above it on the right are misplaced, and their offsets are
+    // written unconditionally while only the counters advance by the comparison
+    static size_t blockPartition(DynamicArray<T>& a, size_t low, size_t high) {
+        std::swap(a[low], a[choosePivot(a, low, high)]);
+        T pivot = a[low];
+
+        unsigned char offsetsLeft[partitionBlock];
+        unsigned char offsetsRight[partitionBlock];
+        size_t countLeft = 0;
+        size_t countRight = 0;
+        size_t startLeft = 0;
+        size_t startRight = 0;
+        size_t left = low + 1;  // First element of the left block
+        size_t right = high - 1; // Last element of the right block
+        while (right + 1 - left >= 2 * partitionBlock) {
+            if (countLeft == 0) {
+                startLeft = 0;
+                for (size_t i = 0; i < partitionBlock; i++) {
+                    offsetsLeft[countLeft] = static_cast<unsigned char>(i);
+                    countLeft += !(a[left + i] < pivot);
+                }
+            }
+            if (countRight == 0) {
+                startRight = 0;
+                for (size_t i = 0; i < partitionBlock; i++) {
+                    offsetsRight[countRight] = static_cast<unsigned char>(i);
+                    countRight += !(pivot < a[right - i]);
+                }
+            }
+
+            size_t swaps = std::min(countLeft, countRight);
+            for (size_t k = 0; k < swaps; k++) {
+                std::swap(a[left + offsetsLeft[startLeft + k]], a[right - offsetsRight[startRight + k]]);
+            }
+            countLeft -= swaps;
+            countRight -= swaps;
+            startLeft += swaps;
+            startRight += swaps;
+            if (countLeft == 0) {
+                left += partitionBlock;
+            }
+            if (countRight == 0) {
+                right -= partitionBlock;
+            }
+        }
+
+        // Everything before left is <= pivot and everything after right is
+        // >= pivot, so a plain Hoare pass finishes the remaining middle
+        size_t i = left - 1;
+        size_t j = right + 1;
+        while (true) {
+            do {
+                i++;
+            } while (i < high && a[i] < pivot);
+            do {
+                j--;
+            } while (pivot < a[j]);
+            if (i >= j) {
+                break;
+            }
+            std::swap(a[i], a[j]);
+        }
+        std::swap(a[low], a[j]);
+        return j;
+    }
+
+    // Intro Sort over the half-open range [low, high)
+    static void introSortLoop(DynamicArray<T>& a, size_t low, size_t high, size_t depthLimit) {
+        while (high - low > introCutoff) {
+            if (depthLimit == 0) {
+                heapSortRange(a, low, high);
+                return;
+            }
+            depthLimit--;
+
+            size_t pi = introPartition(a, low, high);
+
+            // Recur on the smaller partition first
+            if (pi - low < high - pi) {
+                introSortLoop(a, low, pi, depthLimit);
+                low = pi + 1;
+            } else {
+                introSortLoop(a, pi + 1, high, depthLimit);
+                high = pi;
+            }
+        }
+        insertionSortRange(a, low, high);
+    }
+
+    // Index of the median of a[x], a[y], a[z]
+    static size_t medianOfThree(const DynamicArray<T>& a, size_t x, size_t y, size_t z) {
+        if (a[x] < a[y]) {
+            if (a[y] < a[z]) return y;
+            return a[x] < a[z] ? z : x;
+        }
+        if (a[x] < a[z]) return x;
+        return a[y] < a[z] ? z : y;
+    }
+
+    // Pivot index for [low, high): median of the first, middle and last
+    // elements, or above 128 elements Tukey's ninther (median of three such
+    // medians over evenly spaced triples), which resists sorted and organ-pipe inputs
+    static size_t choosePivot(const DynamicArray<T>& a, size_t low, size_t high) {
+        size_t n = high - low;
+        size_t mid = low + n / 2;
+        size_t last = high - 1;
+        if (n > 128) {
+            size_t step = n / 8;
+            return medianOfThree(a,
+                                 medianOfThree(a, low, low + step, low + 2 * step),
+                                 medianOfThree(a, mid - step, mid, mid + step),
+                                 medianOfThree(a, last - 2 * step, last - step, last));
+        }
+        return medianOfThree(a, low, mid, last);
+    }
+
+    // Hoare partition of [low, high) around a median-of-three (or ninther) pivot.
+    // Both scans stop on keys equal to the pivot, so duplicates split evenly.
+    static size_t introPartition(DynamicArray<T>& a, size_t low, size_t high) {
+        return partitionAround(a, low, high, choosePivot(a, low, high));
+    }
+
+    // Hoare partition of [low, high) around a[pivotIndex]; returns the pivot's final index
+    static size_t partitionAround(DynamicArray<T>& a, size_t low, size_t high, size_t pivotIndex) {
+        std::swap(a[low], a[pivotIndex]);
+        T pivot = a[low];
+
+        size_t i = low;
+        size_t j = high;
+        while (true) {
+            do {
+                i++;
+            } while (i < high && a[i] < pivot);
+            do {
+                j--;
+            } while (pivot < a[j]);
+            if (i >= j) {
+                break;
+            }
+            std::swap(a[i], a[j]);
+        }
+        std::swap(a[low], a[j]);
+        return j;
+    }
+
+    // Straight insertion sort of [low, high)
+    static void insertionSortRange(DynamicArray<T>& a, size_t low, size_t high) {
+        for (size_t i = low + 1; i < high; i++) {
+            T key = a[i];
+            size_t j = i;
+            while (j > low && key < a[j - 1]) {
+                a[j] = a[j - 1];
+                j--;
+            }
+            a[j] = key;
+        }
+    }
+
+    // Ranges longer than this pick their pivot with a Floyd-Rivest sample
+    static constexpr size_t floydRivestCutoff = 600;
+
+    // Introselect of rank k within [low, high)
+    static void selectLoop(DynamicArray<T>& a, size_t low, size_t high, size_t k, size_t depthLimit) {
+        while (high - low > introCutoff) {
+            if (depthLimit == 0) {
+                heapSortRange(a, low, high);
+                return;
+            }
+            depthLimit--;
+
+            size_t pivotIndex;
+            size_t n = high - low;
+            if (n > floydRivestCutoff) {
+                // Select k within a sample window of ~n^(2/3) elements around
+                // its expected position; a[k] then splits off nearly all of
+                // the range in one partition (Floyd and Rivest 1975)
+                double i = (double) (k - low + 1);
+                double z = std::log((double) n);
+                double s = 0.5 * std::exp(2.0 * z / 3.0);
+                double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2.0 ? -1.0 : 1.0);
+                double windowLow = (double) k - i * s / n + sd;
+                double windowHigh = (double) k + (n - i) * s / n + sd;
+                size_t sampleLow = (size_t) std::max((double) low, windowLow);
+                size_t sampleHigh = (size_t) std::min((double) (high - 1), windowHigh) + 1;
+                selectLoop(a, sampleLow, sampleHigh, k, depthLimit);
+                pivotIndex = k;
+            } else {
+                pivotIndex = choosePivot(a, low, high);
+            }
+
+            size_t split = partitionAround(a, low, high, pivotIndex);
+            if (split == k) {
+                return;
+            }
+            if (k < split) {
+                high = split;
+            } else {
+                low = split + 1;
+            }
+        }
+        insertionSortRange(a, low, high);
+    }
+
+    // Sift-down in a min-heap of n elements, used by topK
+    static void minHeapSiftDown(T* heap, size_t n, size_t i) {
+        T value = heap[i];
+        while (2 * i + 1 < n) {
+            size_t child = 2 * i + 1;
+            if (child + 1 < n && heap[child + 1] < heap[child]) {
+                child++;
+            }
+            if (!(heap[child] < value)) {
+                break;
+            }
+            heap[i] = heap[child];
+            i = child;
+        }
+        heap[i] = value;
+    }
+
+    // Heap sort of [low, high), used when Intro Sort runs out of depth
+    static void heapSortRange(DynamicArray<T>& a, size_t low, size_t high) {
+        size_t n = high - low;
+        for (size_t i = n / 2; i-- > 0;) {
+            siftDown(a, low, n, i);
+        }
+        for (size_t i = n - 1; i > 0; i--) {
+            std::swap(a[low], a[low + i]);
+            siftDown(a, low, i, 0);
+        }
+    }
+
+    // Iterative sift-down in the max-heap of n elements starting at base
+    static void siftDown(DynamicArray<T>& a, size_t base, size_t n, size_t i) {
+        T value = a[base + i];
+        while (2 * i + 1 < n) {
+            size_t child = 2 * i + 1;
+            if (child + 1 < n && a[base + child] < a[base + child + 1]) {
+                child++;
+            }
+            if (!(value < a[base + child])) {
+                break;
+            }
+            a[base + i] = a[base + child];
+            i = child;
+        }
+        a[base + i] = value;
+    }
+
+    // Ranges shorter than this are merged by a single thread
+    static constexpr size_t parallelMergeCutoff = 1 << 16;
+
+    // Parallel Merge Sort of a[low, high) using buffer[low, high) as scratch
+    static void parallelMergeSortTask(T* a, T* buffer, size_t low, size_t high, ThreadPool& pool) {
+        if (high - low <= parallelCutoff) {
+            mergeSortRange(a, buffer, low, high);
+            return;
+        }
+        size_t mid = low + (high - low) / 2;
+
+        ThreadPool::TaskGroup group;
+        pool.submit(group, [a, buffer, low, mid, &pool] {
+            parallelMergeSortTask(a, buffer, low, mid, pool);
+        });
+        parallelMergeSortTask(a, buffer, mid, high, pool);
+        pool.wait(group);
+
+        parallelMerge(a + low, mid - low, a + mid, high - mid, buffer + low, pool);
+
+        // Copy the merged run back in parallel chunks
+        size_t chunks = std::min(pool.size(), (high - low) / parallelMergeCutoff + 1);
+        size_t chunk = (high - low + chunks - 1) / chunks;
+        ThreadPool::TaskGroup copyGroup;
+        for (size_t start = low; start < high; start += chunk) {
+            size_t end = std::min(high, start + chunk);
+            pool.submit(copyGroup, [a, buffer, start, end] {
+                std::copy(buffer + start, buffer + end, a + start);
+            });
+        }
+        pool.wait(copyGroup);
+    }
+
+    // Number of elements taken from left among the first diagonal outputs of a
+    // stable merge of left and right (merge-path co-rank)
+    static size_t coRank(size_t diagonal, const T* left, size_t leftSize, const T* right, size_t rightSize) {
+        size_t low = diagonal > rightSize ? diagonal - rightSize : 0;
+        size_t high = std::min(diagonal, leftSize);
+        while (true) {
+            size_t i = low + (high - low) / 2;
+            size_t j = diagonal - i;
+            if (i < leftSize && j > 0 && !(right[j - 1] < left[i])) {
+                low = i + 1;    // left[i] must come before right[j - 1]
+            } else if (i > 0 && j < rightSize && right[j] < left[i - 1]) {
+                high = i - 1;   // right[j] must come before left[i - 1]
+            } else {
+                return i;
+            }
+        }
+    }
+
+    // Stable merge of left and right into output, split into one segment per thread
+    static void parallelMerge(const T* left, size_t leftSize, const T* right, size_t rightSize, T* output,
+                              ThreadPool& pool) {
+        size_t total = leftSize + rightSize;
+        size_t segments = std::min(pool.size(), total / parallelMergeCutoff + 1);
+        if (segments <= 1) {
+            mergeRuns(left, leftSize, right, rightSize, output);
+            return;
+        }
+
+        size_t segment = (total + segments - 1) / segments;
+        ThreadPool::TaskGroup group;
+        for (size_t start = 0; start < total; start += segment) {
+            size_t end = std::min(total, start + segment);
+            pool.submit(group, [=] {
+                size_t i = coRank(start, left, leftSize, right, rightSize);
+                size_t iEnd = coRank(end, left, leftSize, right, rightSize);
+                size_t j = start - i;
+                size_t jEnd = end - iEnd;
+                mergeRuns(left + i, iEnd - i, right + j, jEnd - j, output + start);
+            });
+        }
+        pool.wait(group);
+    }
+
+    // Sequential stable two-finger merge of left and right into output
+    static void mergeRuns(const T* left, size_t leftSize, const T* right, size_t rightSize, T* output) {
+        size_t i = 0, j = 0, k = 0;
+        while (i < leftSize && j < rightSize) {
+            if (right[j] < left[i]) {
+                output[k++] = right[j++];
+            } else {
+                output[k++] = left[i++];
+            }
+        }
+        while (i < leftSize) {
+            output[k++] = left[i++];
+        }
+        while (j < rightSize) {
+            output[k++] = right[j++];
+        }
+    }
+
+    // Straight insertion sort of a[low, high) on raw storage
+    static void insertionSortRaw(T* a, size_t low, size_t high) {
+        for (size_t i = low + 1; i < high; i++) {
+            T key = a[i];
+            size_t j = i;
+            while (j > low && key < a[j - 1]) {
+                a[j] = a[j - 1];
+                j--;
+            }
+            a[j] = key;
+        }
+    }
+
+    // Sort [low, high) into target. On entry source and target hold the same
+    // elements there; each level sorts its halves into source and merges them
+    // back into target, so the roles alternate instead of copying
+    static void mergeSortInto(T* source, T* target, size_t low, size_t high) {
+        if (high - low <= introCutoff) {
+            insertionSortRaw(target, low, high);
+            return;
+        }
+        size_t mid = low + (high - low) / 2;
+        mergeSortInto(target, source, low, mid);
+        mergeSortInto(target, source, mid, high);
+        mergeRuns(source + low, mid - low, source + mid, high - mid, target + low);
+    }
+
+    // Sequential top-down merge sort of a[low, high) with buffer[low, high) as scratch
+    static void mergeSortRange(T* a, T* buffer, size_t low, size_t high) {
+        if (high - low <= introCutoff) {
+            insertionSortRaw(a, low, high);
+            return;
+        }
+        size_t mid = low + (high - low) / 2;
+        mergeSortRange(a, buffer, low, mid);
+        mergeSortRange(a, buffer, mid, high);
+        if (!(a[mid] < a[mid - 1])) {
+            return; // Halves already in order
+        }
+        mergeRuns(a + low, mid - low, a + mid, high - mid, buffer + low);
+        std::copy(buffer + low, buffer + high, a + low);
+    }
+
+    // Smallest array autoSort hands to LSD Radix Sort; below it the histogram
+    // setup outweighs the saved comparisons
+    static constexpr size_t autoRadixThreshold = 1 << 12;
+
+    // Byte histogram reading 8 bytes per load (SWAR). Consecutive bytes go to
+    // four interleaved tables so repeated values do not serialize on one counter
+    static void byteHistogram(const unsigned char* bytes, size_t n, size_t* counts) {
+        size_t tables[4][256] = {};
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            tables[0][word & 0xFF]++;
+            tables[1][(word >> 8) & 0xFF]++;
+            tables[2][(word >> 16) & 0xFF]++;
+            tables[3][(word >> 24) & 0xFF]++;
+            tables[0][(word >> 32) & 0xFF]++;
+            tables[1][(word >> 40) & 0xFF]++;
+            tables[2][(word >> 48) & 0xFF]++;
+            tables[3][word >> 56]++;
+        }
+        for (; i < n; i++) {
+            tables[0][bytes[i]]++;
+        }
+        for (size_t byte = 0; byte < 256; byte++) {
+            counts[byte] = tables[0][byte] + tables[1][byte] + tables[2][byte] + tables[3][byte];
+        }
+    }
+
+    static constexpr size_t americanFlagCutoff = 32;
+
+    // Distribute a[0, n) by the 8-bit digit at shift, then recurse into every bucket
+    static void americanFlagSortRange(T* a, size_t n, size_t shift) {
+        if (n <= americanFlagCutoff) {
+            insertionSortRaw(a, 0, n);
+            return;
+        }
+        auto digit = [shift](const T& value) {
+            return static_cast<size_t>((RadixKey<T>::toKey(value) >> shift) & 0xFF);
+        };
+
+        size_t counts[256] = {};
+        for (size_t i = 0; i < n; i++) {
+            counts[digit(a[i])]++;
+        }
+
+        size_t heads[256];
+        size_t tails[256];
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < 256; bucket++) {
+            heads[bucket] = offset;
+            offset += counts[bucket];
+            tails[bucket] = offset;
+        }
+
+        // Swap every misplaced element into the next free slot of its bucket
+        // until the slot being filled receives an element that belongs there
+        if (counts[digit(a[0])] != n) {
+            for (size_t bucket = 0; bucket < 256; bucket++) {
+                while (heads[bucket] < tails[bucket]) {
+                    T value = a[heads[bucket]];
+                    size_t target = digit(value);
+                    while (target != bucket) {
+                        std::swap(value, a[heads[target]++]);
+                        target = digit(value);
+                    }
+                    a[heads[bucket]++] = value;
+                }
+            }
+        }
+
+        if (shift == 0) return;
+        for (size_t bucket = 0; bucket < 256; bucket++) {
+            if (counts[bucket] > 1) {
+                americanFlagSortRange(a + tails[bucket] - counts[bucket], counts[bucket], shift - 8);
+            }
+        }
+    }
+
+    // Run on the powersort stack
+    struct Run {
+        size_t start;
+        size_t length;
+        unsigned power;
+    };
+
+    // Merge buffer (grown on demand, at most half the array) and galloping threshold
+    struct MergeState {
+        std::unique_ptr<T[]> buffer;
+        size_t capacity = 0;
+        size_t minGallop = initialMinGallop;
+
+        T* reserve(size_t count) {
+            if (count > capacity) {
+                capacity = std::max(count, capacity * 2);
+                buffer.reset(new T[capacity]);
+            }
+            return buffer.get();
+        }
+    };
+
+    static constexpr size_t initialMinGallop = 7;
+
+    // Minimum run length from 32 to 64 chosen so n / minRun is close to a power of two
+    static size_t minRunLength(size_t n) {
+        size_t remainder = 0;
+        while (n >= 64) {
+            remainder |= n & 1;
+            n >>= 1;
+        }
+        return n + remainder;
+    }
+
+    // Length of the run starting at a[start]; a strictly descending run is
+    // reversed in place (strictness keeps equal keys in order)
+    static size_t countRunAndMakeAscending(T* a, size_t start, size_t n) {
+        size_t end = start + 1;
+        if (end == n) return 1;
+        if (a[end] < a[start]) {
+            while (end + 1 < n && a[end + 1] < a[end]) end++;
+            std::reverse(a + start, a + end + 1);
+        } else {
+            while (end + 1 < n && !(a[end + 1] < a[end])) end++;
+        }
+        return end + 1 - start;
+    }
+
+    // Powersort node power of the boundary between the adjacent runs
+    // [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2): the first bit in which the
+    // binary fractions of their midpoints (relative to n) differ
+    static unsigned nodePower(size_t s1, size_t n1, size_t n2, size_t n) {
+        unsigned power = 0;
+        size_t a = 2 * s1 + n1;
+        size_t b = a + n1 + n2;
+        while (true) {
+            power++;
+            if (a >= n) {
+                a -= n;
+                b -= n;
+            } else if (b >= n) {
+                break;
+            }
+            a <<= 1;
+            b <<= 1;
+        }
+        return power;
+    }
+
+    // Merge the two runs on top of the stack into one
+    static void mergeTopRuns(T* a, std::vector<Run>& runs, MergeState& state) {
+        Run right = runs.back();
+        runs.pop_back();
+        Run& left = runs.back();
+        mergeAdjacent(a, left.start, right.start, right.start + right.length, state);
+        left.length += right.length;
+    }
+
+    // Stable merge of a[low, mid) and a[mid, high). Elements already in place
+    // at either end are skipped first, then the shorter side goes to the buffer
+    static void mergeAdjacent(T* a, size_t low, size_t mid, size_t high, MergeState& state) {
+        low += std::upper_bound(a + low, a + mid, a[mid]) - (a + low);
+        if (low == mid) return;
+        high = std::lower_bound(a + mid, a + high, a[mid - 1]) - a;
+        if (mid - low <= high - mid) {
+            mergeLow(a, low, mid, high, state);
+        } else {
+            mergeHigh(a, low, mid, high, state);
+        }
+    }
+
+    // Number of leading elements of base[0, len) not greater than key, by
+    // exponential search from the front (upper bound)
+    static size_t gallopRight(const T& key, const T* base, size_t len) {
+        size_t bound = 1;
+        while (bound <= len && !(key < base[bound - 1])) bound *= 2;
+        return std::upper_bound(base + bound / 2, base + std::min(bound, len), key) - base;
+    }
+
+    // Number of leading elements of base[0, len) less than key (lower bound)
+    static size_t gallopLeft(const T& key, const T* base, size_t len) {
+        size_t bound = 1;
+        while (bound <= len && base[bound - 1] < key) bound *= 2;
+        return std::lower_bound(base + bound / 2, base + std::min(bound, len), key) - base;
+    }
+
+    // Number of trailing elements of base[0, len) greater than key, searched from the back
+    static size_t gallopRightFromEnd(const T& key, const T* base, size_t len) {
+        size_t bound = 1;
+        while (bound <= len && key < base[len - bound]) bound *= 2;
+        const T* split = std::upper_bound(base + len - std::min(bound, len), base + len - bound / 2, key);
+        return (base + len) - split;
+    }
+
+    // Number of trailing elements of base[0, len) not less than key, searched from the back
+    static size_t gallopLeftFromEnd(const T& key, const T* base, size_t len) {
+        size_t bound = 1;
+        while (bound <= len && !(base[len - bound] < key)) bound *= 2;
+        const T* split = std::lower_bound(base + len - std::min(bound, len), base + len - bound / 2, key);
+        return (base + len) - split;
+    }
+
+    // Forward merge with the left run in the buffer. After minGallop wins in a
+    // row by one side, whole stretches are located by galloping and copied at
+    // once; the threshold drops while galloping pays off and rises when it stops
+    static void mergeLow(T* a, size_t low, size_t mid, size_t high, MergeState& state) {
+        size_t leftSize = mid - low;
+        T* left = state.reserve(leftSize);
+        std::copy(a + low, a + mid, left);
+        size_t i = 0;
+        size_t j = mid;
+        size_t k = low;
+        while (i < leftSize && j < high) {
+            size_t leftWins = 0;
+            size_t rightWins = 0;
+            while (leftWins < state.minGallop && rightWins < state.minGallop) {
+                if (a[j] < left[i]) {
+                    a[k++] = a[j++];
+                    rightWins++;
+                    leftWins = 0;
+                    if (j == high) break;
+                } else {
+                    a[k++] = left[i++];
+                    leftWins++;
+                    rightWins = 0;
+                    if (i == leftSize) break;
+                }
+            }
+            if (i == leftSize || j == high) break;
+
+            size_t leftRun;
+            size_t rightRun;
+            do {
+                leftRun = gallopRight(a[j], left + i, leftSize - i);
+                k = std::copy(left + i, left + i + leftRun, a + k) - a;
+                i += leftRun;
+                if (i == leftSize) break;
+                a[k++] = a[j++];
+                if (j == high) break;
+
+                rightRun = gallopLeft(left[i], a + j, high - j);
+                k = std::copy(a + j, a + j + rightRun, a + k) - a;
+                j += rightRun;
+                if (j == high) break;
+                a[k++] = left[i++];
+                if (i == leftSize) break;
+
+                if (state.minGallop > 1) state.minGallop--;
+            } while (leftRun >= initialMinGallop || rightRun >= initialMinGallop);
+            state.minGallop += 2;
+        }
+        std::copy(left + i, left + leftSize, a + k); // The rest of the right run is in place
+    }
+
+    // Mirror of mergeLow: the right run goes to the buffer and the merge runs backwards
+    static void mergeHigh(T* a, size_t low, size_t mid, size_t high, MergeState& state) {
+        size_t rightSize = high - mid;
+        T* right = state.reserve(rightSize);
+        std::copy(a + mid, a + high, right);
+        size_t i = mid;
+        size_t j = rightSize;
+        size_t k = high;
+        while (i > low && j > 0) {
+            size_t leftWins = 0;
+            size_t rightWins = 0;
+            while (leftWins < state.minGallop && rightWins < state.minGallop) {
+                if (right[j - 1] < a[i - 1]) {
+                    a[--k] = a[--i];
+                    leftWins++;
+                    rightWins = 0;
+                    if (i == low) break;
+                } else {
+                    a[--k] = right[--j];
+                    rightWins++;
+                    leftWins = 0;
+                    if (j == 0) break;
+                }
+            }
+            if (i == low || j == 0) break;
+
+            size_t leftRun;
+            size_t rightRun;
+            do {
+                leftRun = gallopRightFromEnd(right[j - 1], a + low, i - low);
+                std::copy_backward(a + i - leftRun, a + i, a + k);
+                k -= leftRun;
+                i -= leftRun;
+                if (i == low) break;
+                a[--k] = right[--j];
+                if (j == 0) break;
+
+                rightRun = gallopLeftFromEnd(a[i - 1], right, j);
+                std::copy(right + j - rightRun, right + j, a + k - rightRun);
+                k -= rightRun;
+                j -= rightRun;
+                if (j == 0) break;
+                a[--k] = a[--i];
+                if (i == low) break;
+
+                if (state.minGallop > 1) state.minGallop--;
+            } while (leftRun >= initialMinGallop || rightRun >= initialMinGallop);
+            state.minGallop += 2;
+        }
+        std::copy(right, right + j, a + low); // The rest of the left run is in place
+    }
+
+    static void prefetch(const void* address) {
+#if defined(__GNUC__)
+        __builtin_prefetch(address);
+#else
+        (void) address;
+#endif
+    }
+
+    // Index of the largest child of node, whose first child is at first < n.
+    // The grandchildren block is prefetched first, so the next level's loads
+    // overlap with these comparisons
+    template <size_t D>
+    static size_t dAryLargestChild(const T* a, size_t n, size_t first) {
+        size_t grandchildren = D * first + 1;
+        if (grandchildren < n) {
+            const char* block = reinterpret_cast<const char*>(a + grandchildren);
+            size_t bytes = std::min(D * D, n - grandchildren) * sizeof(T);
+            for (size_t offset = 0; offset < bytes; offset += 64) {
+                prefetch(block + offset);
+            }
+        }
+        size_t largest = first;
+        size_t last = std::min(first + D, n);
+        for (size_t child = first + 1; child < last; child++) {
+            if (a[largest] < a[child]) {
+                largest = child;
+            }
+        }
+        return largest;
+    }
+
+    // Sift a[hole] down, moving larger children up into the hole
+    template <size_t D>
+    static void dArySiftDown(T* a, size_t n, size_t hole) {
+        T value = a[hole];
+        for (size_t first = D * hole + 1; first < n; first = D * hole + 1) {
+            size_t largest = dAryLargestChild<D>(a, n, first);
+            if (!(value < a[largest])) {
+                break;
+            }
+            a[hole] = a[largest];
+            hole = largest;
+        }
+        a[hole] = value;
+    }
+
+    // Floyd's sift: the hole at the root descends along the largest children
+    // to a leaf without comparing against value (which almost always belongs
+    // near the bottom), then value climbs back up to its place
+    template <size_t D>
+    static void dArySiftBottomUp(T* a, size_t n, const T& value) {
+        size_t hole = 0;
+        for (size_t first = 1; first < n; first = D * hole + 1) {
+            size_t largest = dAryLargestChild<D>(a, n, first);
+            a[hole] = a[largest];
+            hole = largest;
+        }
+        while (hole > 0) {
+            size_t parent = (hole - 1) / D;
+            if (!(a[parent] < value)) {
+                break;
+            }
+            a[hole] = a[parent];
+            hole = parent;
+        }
+        a[hole] = value;
+    }
+
+    static bool equivalent(const T& x, const T& y) {
+        return !(x < y) && !(y < x);
+    }
+
+    // Dual-Pivot Quick Sort over [low, high)
+    static void dualPivotQuickSortLoop(DynamicArray<T>& a, size_t low, size_t high, size_t depthLimit,
+                                       const DualPivotSettings& settings) {
+        while (high - low > settings.cutoff) {
+            if (depthLimit == 0) {
+                heapSortRange(a, low, high);
+                return;
+            }
+            depthLimit--;
+
+            // Sort five evenly spaced elements in place and take two of them
+            size_t length = high - low;
+            size_t sample[dualPivotSample];
+            for (size_t s = 0; s < dualPivotSample; s++) {
+                sample[s] = low + (s + 1) * length / (dualPivotSample + 1);
+            }
+            for (size_t s = 1; s < dualPivotSample; s++) {
+                T key = a[sample[s]];
+                size_t t = s;
+                while (t > 0 && key < a[sample[t - 1]]) {
+                    a[sample[t]] = a[sample[t - 1]];
+                    t--;
+                }
+                a[sample[t]] = key;
+            }
+
+            size_t last = high - 1;
+            if (!(a[sample[settings.lowRank]] < a[sample[settings.highRank]])) {
+                // Equal pivots leave nothing for the middle part; group the
+                // duplicates with a three-way partition instead
+                threeWayQuickSortLoop(a, low, high, depthLimit);
+                return;
+            }
+            std::swap(a[low], a[sample[settings.lowRank]]);
+            std::swap(a[last], a[sample[settings.highRank]]);
+            T p = a[low];
+            T q = a[last];
+
+            // a(low, less) < p, a[less, k) in [p, q], a(great, last) > q
+            size_t less = low + 1;
+            size_t great = last - 1;
+            for (size_t k = less; k <= great; k++) {
+                if (a[k] < p) {
+                    std::swap(a[k], a[less++]);
+                } else if (q < a[k]) {
+                    while (q < a[great] && k < great) {
+                        great--;
+                    }
+                    std::swap(a[k], a[great--]);
+                    if (a[k] < p) {
+                        std::swap(a[k], a[less++]);
+                    }
+                }
+            }
+
+            // Move the pivots between the three parts
+            less--;
+            great++;
+            std::swap(a[low], a[less]);
+            std::swap(a[last], a[great]);
+
+            // Recur on the two smaller parts and keep looping on the largest one
+            size_t ranges[3][2] = {{low, less}, {less + 1, great}, {great + 1, high}};
+            size_t largest = 0;
+            for (size_t r = 1; r < 3; r++) {
+                if (ranges[r][1] - ranges[r][0] > ranges[largest][1] - ranges[largest][0]) {
+                    largest = r;
+                }
+            }
+            for (size_t r = 0; r < 3; r++) {
+                if (r != largest) {
+                    dualPivotQuickSortLoop(a, ranges[r][0], ranges[r][1], depthLimit, settings);
+                }
+            }
+            low = ranges[largest][0];
+            high = ranges[largest][1];
+        }
+        insertionSortRange(a, low, high);
+    }
+
+    // One level of 3-Way Quick Sort over [low, high)
+    static void threeWayQuickSortLoop(DynamicArray<T>& a, size_t low, size_t high, size_t depthLimit) {
+        while (high - low > introCutoff) {
+            if (depthLimit == 0) {
+                heapSortRange(a, low, high);
+                return;
+            }
+            depthLimit--;
+
+            std::swap(a[low], a[choosePivot(a, low, high)]);
+            T pivot = a[low];
+
+            // Signed indices: j and the equal-key cursors may step to low - 1.
+            // a[l, p] and a[q, r] hold keys equal to the pivot, a(p, i) keys
+            // below it and a(j, q) keys above it
+            const ptrdiff_t l = (ptrdiff_t) low;
+            const ptrdiff_t r = (ptrdiff_t) high - 1;
+            ptrdiff_t i = l;
+            ptrdiff_t j = r + 1;
+            ptrdiff_t p = l;
+            ptrdiff_t q = r + 1;
+            while (true) {
+                while (a[++i] < pivot) {
+                    if (i == r) break;
+                }
+                while (pivot < a[--j]) {
+                    if (j == l) break;
+                }
+                if (i == j && equivalent(a[i], pivot)) {
+                    std::swap(a[++p], a[i]);
+                }
+                if (i >= j) break;
+
+                std::swap(a[i], a[j]);
+                if (equivalent(a[i], pivot)) std::swap(a[++p], a[i]);
+                if (equivalent(a[j], pivot)) std::swap(a[--q], a[j]);
+            }
+
+            // Swap the equal keys from both ends into the middle
+            i = j + 1;
+            for (ptrdiff_t k = l; k <= p; k++) {
+                std::swap(a[k], a[j--]);
+            }
+            for (ptrdiff_t k = r; k >= q; k--) {
+                std::swap(a[k], a[i++]);
+            }
+
+            // Now [low, j] < pivot, (j, i) == pivot and [i, high) > pivot;
+            // recurse into the smaller side and keep looping on the larger one
+            size_t lessEnd = (size_t) (j + 1);
+            size_t greaterBegin = (size_t) i;
+            if (lessEnd - low < high - greaterBegin) {
+                threeWayQuickSortLoop(a, low, lessEnd, depthLimit);
+                low = greaterBegin;
+            } else {
+                threeWayQuickSortLoop(a, greaterBegin, high, depthLimit);
+                high = lessEnd;
+            }
+        }
+        insertionSortRange(a, low, high);
+    }
+
     // Helper for Merge Sort
     static void mergeSortHelper(DynamicArray<T>* data, size_t left, size_t right) {
+        if (right - left < SimdSort<T>::blockSize && SimdSort<T>::available()) {
+            SimdSort<T>::sortBlock(data->data() + left, right - left + 1); // Vector sorting network
+            return;
+        }
         if (left < right) {
             size_t mid = left + (right - left) / 2;
 
@@ -219,6 +1806,7 @@ private:
 
     // Merge function for Merge Sort
     static void merge(DynamicArray<T>* data, size_t left, size_t mid, size_t right) {
+        DynamicArray<T>& a = *data;
         size_t n1 = mid - left + 1;
         size_t n2 = right - mid;
 
@@ -226,32 +1814,39 @@ private:
         T* rightArray = new T[n2];
 
         for (size_t i = 0; i < n1; ++i) {
-            leftArray[i] = data->get(left + i);
+            leftArray[i] = a[left + i];
         }
         for (size_t j = 0; j < n2; ++j) {
-            rightArray[j] = data->get(mid + 1 + j);
+            rightArray[j] = a[mid + 1 + j];
+        }
+
+        if (SimdSort<T>::available()) {
+            SimdSort<T>::mergeRuns(leftArray, n1, rightArray, n2, data->data() + left); // Bitonic vector merge
+            delete[] leftArray;
+            delete[] rightArray;
+            return;
         }
 
         size_t i = 0, j = 0, k = left;
         while (i < n1 && j < n2) {
             if (leftArray[i] <= rightArray[j]) {
-                data->set(k, leftArray[i]);
+                a[k] = leftArray[i];
                 ++i;
             } else {
-                data->set(k, rightArray[j]);
+                a[k] = rightArray[j];
                 ++j;
             }
             ++k;
         }
 
         while (i < n1) {
-            data->set(k, leftArray[i]);
+            a[k] = leftArray[i];
             ++i;
             ++k;
         }
 
         while (j < n2) {
-            data->set(k, rightArray[j]);
+            a[k] = rightArray[j];
             ++j;
             ++k;
         }
@@ -261,91 +1856,79 @@ private:
     }
 
     // Partition function for Quick Sort
-    static int partition(DynamicArray<T>* data, int low, int high) {
-        T pivot = data->get(high);
-        int i = (low - 1);
-        for (int j = low; j < high; j++) {
-            if (data->get(j) < pivot) {
+    static ptrdiff_t partition(DynamicArray<T>* data, ptrdiff_t low, ptrdiff_t high) {
+        DynamicArray<T>& a = *data;
+        T pivot = a[high];
+        ptrdiff_t i = (low - 1);
+        for (ptrdiff_t j = low; j < high; j++) {
+            if (a[j] < pivot) {
                 i++;
-                T temp = data->get(i);
-                data->set(i, data->get(j));
-                data->set(j, temp);
+                std::swap(a[i], a[j]);
             }
         }
-        T temp = data->get(i + 1);
-        data->set(i + 1, data->get(high));
-        data->set(high, temp);
+        std::swap(a[i + 1], a[high]);
         return (i + 1);
     }
 
     // Descending partition function for Quick Sort
-    static int partitionDesc(DynamicArray<T>* data, int low, int high) {
-        T pivot = data->get(high);
-        int i = (low - 1);
-        for (int j = low; j < high; j++) {
-            if (data->get(j) > pivot) {
+    static ptrdiff_t partitionDesc(DynamicArray<T>* data, ptrdiff_t low, ptrdiff_t high) {
+        DynamicArray<T>& a = *data;
+        T pivot = a[high];
+        ptrdiff_t i = (low - 1);
+        for (ptrdiff_t j = low; j < high; j++) {
+            if (a[j] > pivot) {
                 i++;
-                T temp = data->get(i);
-                data->set(i, data->get(j));
-                data->set(j, temp);
+                std::swap(a[i], a[j]);
             }
         }
-        T temp = data->get(i + 1);
-        data->set(i + 1, data->get(high));
-        data->set(high, temp);
+        std::swap(a[i + 1], a[high]);
         return (i + 1);
     }
 
-    static int drunkPartition(DynamicArray<T>* data, int low, int high, int drunkLevel) {
-        int pivotIndex = high;
+    static ptrdiff_t drunkPartition(DynamicArray<T>* data, ptrdiff_t low, ptrdiff_t high, int drunkLevel) {
+        DynamicArray<T>& a = *data;
+        ptrdiff_t pivotIndex = high;
 
         if (drunkLevel > 0) {
-            int range = high - low + 1;
-            int offset = rand() % std::min(range, drunkLevel + 1);
+            ptrdiff_t range = high - low + 1;
+            ptrdiff_t offset = rand() % std::min<ptrdiff_t>(range, drunkLevel + 1);
             pivotIndex = low + offset;
         }
 
-        T pivotValue = data->get(pivotIndex);
-        data->set(pivotIndex, data->get(high));
-        data->set(high, pivotValue);
+        std::swap(a[pivotIndex], a[high]);
 
-        T pivot = data->get(high);
-        int i = (low - 1);
-        for (int j = low; j < high; j++) {
-            if (data->get(j) < pivot) {
+        T pivot = a[high];
+        ptrdiff_t i = (low - 1);
+        for (ptrdiff_t j = low; j < high; j++) {
+            if (a[j] < pivot) {
                 i++;
-                T temp = data->get(i);
-                data->set(i, data->get(j));
-                data->set(j, temp);
+                std::swap(a[i], a[j]);
             }
         }
-        T temp = data->get(i + 1);
-        data->set(i + 1, data->get(high));
-        data->set(high, temp);
+        std::swap(a[i + 1], a[high]);
         return (i + 1);
     }
 
 
     // Heapify function for Heap Sort
-    static void heapify(DynamicArray<T>* data, int n, int i) {
-        int largest = i;
-        int left = 2 * i + 1;
-        int right = 2 * i + 2;
+    static void heapify(DynamicArray<T>* data, size_t n, size_t i) {
+        DynamicArray<T>& a = *data;
+        size_t largest = i;
+        size_t left = 2 * i + 1;
+        size_t right = 2 * i + 2;
 
-        if (left < n && data->get(left) > data->get(largest)) {
+        if (left < n && a[left] > a[largest]) {
             largest = left;
         }
-        if (right < n && data->get(right) > data->get(largest)) {
+        if (right < n && a[right] > a[largest]) {
             largest = right;
         }
         if (largest != i) {
-            T temp = data->get(i);
-            data->set(i, data->get(largest));
-            data->set(largest, temp);
+            std::swap(a[i], a[largest]);
             heapify(data, n, largest);
         }
     }
 
 };
 
-#endif // AIZOPROJEKT_SORTER_H
\ No newline at end of file
+#endif // AIZOPROJEKT_SORTER_H
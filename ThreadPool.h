@@ -0,0 +1,194 @@
+#ifndef AIZOPROJEKT_THREADPOOL_H
+#define AIZOPROJEKT_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Every worker owns a deque: it pushes and pops
+// its own tasks at the back (depth first, cache warm) while idle workers
+// steal from the front of other deques (the oldest, largest tasks).
+// Threads outside the pool submit into a shared injection deque and help
+// execute tasks while they wait for a TaskGroup.
+class ThreadPool {
+public:
+    // Set of tasks that can be waited for together
+    class TaskGroup {
+    public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+    private:
+        friend class ThreadPool;
+        std::atomic<size_t> pending{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    // Pool running tasks on threads - 1 workers plus the waiting thread
+    explicit ThreadPool(size_t threads) : queues(std::max<size_t>(threads, 1)) {
+        for (size_t i = 0; i + 1 < queues.size(); i++) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Number of threads taking part in the work, including the waiting one
+    size_t size() const {
+        return queues.size();
+    }
+
+    // Queue a task; it runs on any pool thread or on a thread waiting in wait()
+    void submit(TaskGroup& group, std::function<void()> task) {
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        queued.fetch_add(1, std::memory_order_release);
+        Queue& queue = queues[ownQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back({std::move(task), &group});
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wakeUp.notify_one();
+    }
+
+    // Run queued tasks until every task of the group has finished, then
+    // rethrow the first exception any of them raised
+    void wait(TaskGroup& group) {
+        while (group.pending.load(std::memory_order_acquire) > 0) {
+            if (!runOne()) {
+                std::this_thread::yield();
+            }
+        }
+        if (group.error) {
+            std::exception_ptr error = group.error;
+            group.error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Pool shared by the sorting algorithms, recreated when the thread count changes
+    static ThreadPool& shared(size_t threads) {
+        static std::unique_ptr<ThreadPool> pool;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (!pool || pool->size() != threads) {
+            pool.reset();
+            pool = std::make_unique<ThreadPool>(threads);
+        }
+        return *pool;
+    }
+
+private:
+    struct Task {
+        std::function<void()> function;
+        TaskGroup* group;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // queues[i] belongs to worker i, the last one is the injection queue
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    bool stopping = false;
+
+    // Pool and queue of the calling worker thread (nullptr outside any pool)
+    static inline thread_local const ThreadPool* currentPool = nullptr;
+    static inline thread_local size_t currentIndex = 0;
+
+    size_t ownQueue() const {
+        return currentPool == this ? currentIndex : queues.size() - 1;
+    }
+
+    // Pop from our own queue, otherwise steal from the others
+    bool take(Task& task) {
+        size_t self = ownQueue();
+        {
+            Queue& queue = queues[self];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues.size(); offset++) {
+            Queue& victim = queues[(self + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool runOne() {
+        if (queued.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        Task task;
+        if (!take(task)) {
+            return false;
+        }
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        try {
+            task.function();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(task.group->errorMutex);
+            if (!task.group->error) {
+                task.group->error = std::current_exception();
+            }
+        }
+        task.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    void workerLoop(size_t index) {
+        currentPool = this;
+        currentIndex = index;
+        while (true) {
+            if (runOne()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+            if (stopping) {
+                return;
+            }
+        }
+    }
+};
+
+#endif // AIZOPROJEKT_THREADPOOL_H
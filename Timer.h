@@ -18,26 +18,29 @@ public:
     }
 
     int start() {
-        startTime = (int) std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::high_resolution_clock::now().time_since_epoch())
-                .count();
+        startTime = now();
         return 0;
     }
 
     int stop() {
-        stopTime = (int) std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::high_resolution_clock::now().time_since_epoch())
-                .count();
+        stopTime = now();
         return 0;
     }
 
-    int result() const {
+    // Elapsed milliseconds; 64-bit so long runs and epoch-based stamps never wrap
+    long long result() const {
         return stopTime - startTime;
     }
 
 private:
-    int startTime;
-    int stopTime;
+    long long startTime;
+    long long stopTime;
+
+    static long long now() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+    }
 };
 
 